@@ -42,6 +42,7 @@ SOURCES = \
    $$PWD/PovRay.C \
    $$PWD/RemSectionData.C \
    $$PWD/Shell.C \
+   $$PWD/ShellKernels.C \
    $$PWD/ShellList.C \
    $$PWD/Surface.C \
    $$PWD/SurfaceInfo.C \
@@ -94,6 +95,7 @@ HEADERS = \
    $$PWD/RemSectionData.h \
    $$PWD/Serialization.h \
    $$PWD/Shell.h \
+   $$PWD/ShellKernels.h \
    $$PWD/ShellList.h \
    $$PWD/Surface.h \
    $$PWD/SurfaceInfo.h \
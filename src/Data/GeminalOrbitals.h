@@ -68,6 +68,7 @@ namespace Data {
          QList<double> const& geminalCoefficients() const { return  m_geminalCoefficients;}
          QList<int> const& geminalMoMap() const { return  m_geminalMoMap;}
          ShellList const& shellList() const { return m_shellList; }
+         ShellList& shellList() { return m_shellList; }
          SurfaceList& surfaceList() { return m_surfaceList; }
 
          void appendSurface(Data::Surface* surfaceData)
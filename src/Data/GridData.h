@@ -27,28 +27,157 @@
 #include "SurfaceType.h"
 #include "Geometry.h"
 #include "Matrix.h"
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QAtomicInt>
 #include <vector>
 
 
+class QDataStream;
+
+
 namespace IQmol {
 namespace Data {
 
    class GridSize;
 
-   /// Basic Data class for holding real data on a 3D grid.
+   /// Basic Data class for holding real data on a 3D grid.  Values can be 
+   /// held in either double or single precision and idle grids can be 
+   /// compressed.  Compressed grids must be expanded before the values are
+   /// accessed, code that reads or writes a grid on a worker thread should
+   /// hold an InUse object for the duration so the grid is not compressed
+   /// underneath it.
+   ///
+   /// Grids can also be sparse, in which case only selected bricks of 
+   /// BrickSize^3 points are allocated.  Points in the missing bricks read
+   /// as zero and writes to them are discarded.
    class GridData : public Base {
 
       using Base::copy;
       friend class boost::serialization::access;
 
       public:
+         enum Precision { Double, Single };
+         enum { BrickShift = 3, BrickSize = 1 << BrickShift };
+
+         /// Proxy returned by the non-const element accessor so that values 
+         /// can be assigned irrespective of the storage precision.
+         class Reference {
+            public:
+               Reference(GridData& grid, unsigned const index) : m_grid(grid), 
+                  m_index(index) { }
+
+               operator double() const { return m_grid.at(m_index); }
+
+               Reference& operator=(double const value) 
+               {
+                  m_grid.set(m_index, value);
+                  return *this;
+               }
+
+               Reference& operator=(Reference const& that) 
+               {
+                  return operator=(double(that));
+               }
+
+               Reference& operator+=(double const value) 
+               {
+                  return operator=(m_grid.at(m_index) + value);
+               }
+
+               Reference& operator-=(double const value) 
+               {
+                  return operator=(m_grid.at(m_index) - value);
+               }
+
+               Reference& operator*=(double const value) 
+               {
+                  return operator=(m_grid.at(m_index) * value);
+               }
+
+            private:
+               GridData& m_grid;
+               unsigned m_index;
+         };
+
+         /// Expands the grid and keeps compress() from touching it while 
+         /// the object is in scope.
+         class InUse {
+            public:
+               explicit InUse(GridData const& grid) : m_grid(grid) { m_grid.acquire(); }
+               ~InUse() { m_grid.release(); }
+
+            private:
+               InUse(InUse const&);
+               InUse& operator=(InUse const&);
+               GridData const& m_grid;
+         };
+
          Type::ID typeID() const { return Type::GridData; }
 
          GridData(GridSize const&, SurfaceType const&);
          GridData(GridSize const&, SurfaceType const&, QList<double> const& data);
          GridData(GridData const&);
 
-         GridData() { }  // for boost::serialize;
+         GridData();  // for boost::serialize;
+
+         Precision precision() const { return m_precision; }
+
+         /// Converts the stored values to the given precision.
+         void setPrecision(Precision const);
+
+         /// Compresses the grid data in fixed size chunks.  The lossy mode
+         /// converts the data to single precision and rounds away the low-order
+         /// mantissa bits, giving a relative error below 1 part in 8000.  Grids
+         /// that are in use are left alone.
+         void compress(bool const lossy = false);
+
+         bool isCompressed() const { return m_compressed.loadAcquire() != 0; }
+
+         /// Restores the compressed data.  The element accessors do not do 
+         /// this, so it must be called before the values are accessed.
+         void expand() const { if (m_compressed.loadAcquire()) decompress(); }
+
+		 /// Expands the data and discards the cached range and isovalue maps.
+		 /// This should be called on a single thread before the grid is 
+         /// filled by several workers.
+         void prepareForWrite() { expand(); invalidateRange(); }
+
+		 /// Number of bricks along each axis, those at the upper edges may 
+         /// extend beyond the grid.
+         void getNumberOfBricks(unsigned& bx, unsigned& by, unsigned& bz) const;
+
+		 /// Allocates only the bricks with a non-zero mask entry (ordered as
+		 /// [bx][by][bz]), an empty mask makes the grid dense.  Values in the
+         /// bricks that remain allocated are preserved.
+         void setBrickMask(std::vector<char> const& mask);
+
+         bool isSparse() const { return !m_brickOffset.empty(); }
+
+         /// Writes the precision, the brick mask and the stored values to the
+         /// stream, the values as a single block in the storage layout and 
+         /// host byte order.  Used by the GridCache.
+         bool writeRawData(QDataStream&) const;
+
+         /// Reads the data written by writeRawData into a grid of the same 
+         /// number of points, restoring the precision and sparsity of the 
+         /// original.
+         bool readRawData(QDataStream&);
+
+         unsigned nAllocatedBricks() const;
+
+         bool hasBrick(unsigned const a, unsigned const b, unsigned const c) const
+         {
+            return m_brickOffset.empty() || 
+               m_brickOffset[(a*m_nBricks[1] + b)*m_nBricks[2] + c] != s_missing;
+         }
+
+         /// Returns false if the point lies in a missing brick
+         bool isAllocated(unsigned const i, unsigned const j, unsigned const k) const
+         {
+            return hasBrick(i >> BrickShift, j >> BrickShift, k >> BrickShift);
+         }
 
          void getNumberOfPoints(unsigned& nx, unsigned& ny, unsigned& nz) const;
 
@@ -56,8 +185,16 @@ namespace Data {
 
          void getRange(double& min, double& max);
 
+         /// Returns the isovalue enclosing the given percentage of the 
+         /// (squared, for orbitals) values, negative percentages refer to
+         /// the negative lobes.  
          double percentToIsovalue(int percent);
 
+		 /// Builds the maps used by percentToIsovalue in O(N) time.  This is
+		 /// thread safe and is called once the grid has been evaluated so
+		 /// the maps are normally available before they are first needed.
+         void computeIsovalueMap();
+
          double dataSizeInKb() const;
 
          SurfaceType const& surfaceType() const { return m_surfaceType; }
@@ -80,16 +217,25 @@ namespace Data {
          GridData& operator-=(GridData const& that);
          GridData& operator*=(double const that);
 
-         double const& operator()(unsigned const i, unsigned const j, unsigned const k) const
+         // The accessors assume the grid has been expanded and, for writes,
+         // that prepareForWrite() has been called.
+         double operator()(unsigned const i, unsigned const j, unsigned const k) const
          {
-            return m_data[i][j][k];
+            return at(index(i, j, k));
          }
 
-         double& operator()(unsigned const i, unsigned const j, unsigned const k)
+         Reference operator()(unsigned const i, unsigned const j, unsigned const k)
          {
-            return m_data[i][j][k];
+            return Reference(*this, index(i, j, k));
          }
 
+		 /// Returns the (a,b,c) indices of the bricks containing cubes that 
+		 /// straddle the isovalue, i.e. with min <= isovalue < max over their 
+		 /// corners.  Brick (a,b,c) holds the cubes whose lowest corner is in
+		 /// brick (a,b,c) of the grid points.  The search uses a min/max 
+         /// pyramid over the bricks which is built on first use.
+         void activeBricks(double const isovalue, std::vector<unsigned>& bricks) const;
+
 		 /// Performs a tri-linear interpolation of the grid data at each of 
 		 /// the 8 nearest grid points about (x,y,z). Returns 0 outside the 
          /// range of the grid
@@ -103,21 +249,24 @@ namespace Data {
          // computes this = a*this + b*B
          void combine(double const a, double const b, GridData const& B);
 
+         // The values are archived as an Array3D, as they were before the
+         // storage precision and layout were made configurable.
          void serialize(InputArchive& ar, unsigned const version = 0) 
          {
             privateSerialize(ar, version);
+            loadData(ar);
          }
 
          void serialize(OutputArchive& ar, unsigned const version = 0) 
          {
             privateSerialize(ar, version);
+            saveData(ar);
          }
 
          void dump() const;
 
       private:
          void copy(GridData const&);
-         std::vector<double> sortData(bool const squareData);
 
          template <class Archive>
          void privateSerialize(Archive& ar, unsigned const) 
@@ -125,13 +274,120 @@ namespace Data {
             ar & m_surfaceType;
             ar & m_origin;
             ar & m_delta;
-            ar & m_data;
+         }
+
+         void loadData(InputArchive&);
+         void saveData(OutputArchive&) const;
+
+         void allocate(unsigned const nx, unsigned const ny, unsigned const nz);
+         void decompress() const;
+         void convertPrecision(Precision const);
+
+         void acquire() const;
+         void release() const { m_users.deref(); }
+
+         void allocateStorage(unsigned const n);
+
+         // Sets the brick offsets for the mask and returns the storage size
+         unsigned setBrickOffsets(std::vector<char> const& mask);
+
+         // Resampling engine used by combine().  Rows run along k and are 
+         // accessed in contiguous segments, which are whole rows for a dense
+         // grid and the part of the row within a brick otherwise.
+         bool latticeOffset(GridData const& B, int offset[3]) const;
+         void combineShifted(double const a, double const b, GridData const& B,
+            int const offset[3]);
+         void combineInterpolated(double const a, double const b, GridData const& B);
+
+         void getRow(unsigned const i, unsigned const j, unsigned const k, 
+            unsigned const n, double* row) const;
+         void axpyRow(unsigned const i, unsigned const j, unsigned const k, 
+            unsigned const n, double const a, double const b, double const* row);
+
+         // The min/max pyramid and the percentage maps are discarded 
+         // whenever the data are modified
+         void invalidateRange() { 
+            m_rangeValid.storeRelease(0); 
+            m_isovalueMapValid.storeRelease(0); 
+         }
+         void buildRange() const;
+         void activeBricks(unsigned const level, unsigned const a, unsigned const b,
+            unsigned const c, double const isovalue, std::vector<unsigned>& bricks) const;
+
+         // Storage offset of the point, s_missing if it lies in a missing brick.
+         // Within a brick the points are ordered as for the dense grid.
+         unsigned index(unsigned const i, unsigned const j, unsigned const k) const
+         {
+            if (m_brickOffset.empty()) return (i*m_nPoints[1] + j)*m_nPoints[2] + k;
+
+            unsigned brick(((i >> BrickShift)*m_nBricks[1] + (j >> BrickShift))
+               *m_nBricks[2] + (k >> BrickShift));
+            unsigned offset(m_brickOffset[brick]);
+            if (offset == s_missing) return s_missing;
+
+            unsigned const mask(BrickSize-1);
+            return offset + ((((i & mask) << BrickShift) + (j & mask)) << BrickShift) 
+                          + (k & mask);
+         }
+
+         unsigned storageSize() const 
+         {
+            return m_precision == Single ? m_single.size() : m_double.size();
+         }
+
+         // These assume the data have been expanded
+         double at(unsigned const n) const 
+         {
+            if (n == s_missing) return 0.0;
+            return m_precision == Single ? double(m_single[n]) : m_double[n];
+         }
+
+         double at(unsigned const i, unsigned const j, unsigned const k) const
+         {
+            return at(index(i, j, k));
+         }
+
+         void set(unsigned const n, double const value)
+         {
+            if (n == s_missing) {
+               return;
+            }else if (m_precision == Single) {
+               m_single[n] = float(value);
+            }else {
+               m_double[n] = value;
+            }
          }
 
          SurfaceType m_surfaceType;
          qglviewer::Vec m_origin;
          qglviewer::Vec m_delta;
-         Array3D m_data;
+         static unsigned const s_missing = ~0u;
+
+         unsigned m_nPoints[3];
+         unsigned m_nBricks[3];
+         Precision m_precision;
+
+         // Storage offset of each brick, empty for a dense grid
+         std::vector<unsigned> m_brickOffset;
+
+         mutable std::vector<double> m_double;
+         mutable std::vector<float>  m_single;
+         mutable QList<QByteArray>   m_chunks;
+         // The flags are atomic as they are tested without the locks
+         mutable QAtomicInt m_compressed;
+         mutable QAtomicInt m_users;
+         mutable QMutex     m_mutex;
+
+		 // Level 0 of the pyramid holds the range of the values over the cubes
+		 // in each brick, each subsequent level the range over 2x2x2 blocks of
+         // the level below.  The dimensions of each level are stored in triples.
+         mutable std::vector< std::vector<double> > m_rangeMin;
+         mutable std::vector< std::vector<double> > m_rangeMax;
+         mutable std::vector<unsigned> m_rangeDims;
+         mutable QAtomicInt m_rangeValid;
+
+         mutable QMutex m_isovalueMutex;
+         QAtomicInt m_isovalueMapValid;
          Vector  m_percentToIsovaluePositive; 
          Vector  m_percentToIsovalueNegative; 
    };
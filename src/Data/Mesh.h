@@ -83,6 +83,9 @@ namespace Data {
          Vertex addVertex(double const x, double const y, double const z);
          Face   addFace(Vertex const& v0, Vertex const& v1, Vertex const& v2);
 
+         /// Preallocates space for the given number of vertices and faces
+         void reserve(unsigned const nVertices, unsigned const nFaces);
+
          void setNormal(Vertex const& handle, double dx, double dy, double dz);
          void setNormal(Vertex const& handle, Normal const& normal);
          void setPoint(Vertex const& handle, Point const& p);
@@ -111,6 +114,12 @@ namespace Data {
          void deleteProperty(Property const property);
 
          bool computeScalarField(Function3D const&);
+
+		 /// Batched version of the above.  The vertices are passed to the 
+		 /// functions in contiguous blocks and evaluated concurrently, one 
+		 /// worker thread per function.  The functions must therefore not share
+         /// any scratch space, and each must return an n x 1 matrix of values.
+         bool computeScalarField(QList<MultiFunction3DBlock> const&);
          bool computeIndexField();
 
          void getScalarFieldRange(double& min, double& max);
@@ -24,6 +24,7 @@
 
 #include "QGLViewer/vec.h"
 #include "Data.h"
+#include <vector>
 
 
 namespace IQmol {
@@ -60,12 +61,37 @@ namespace Data {
             double const thresh = 0.001);
 
 		 // Returns a pointer to an array containing the values of the basis
-		 // functions at the given position.
+		 // functions at the given position.  These use the static buffer
+         // and so are not thread safe.
          double const* evaluate(qglviewer::Vec const& gridPoint) const;
          double const* evaluate(double const x, double const y, double const z) const;
 
+         /// Thread safe version which writes the values into the supplied 
+         /// buffer of length at least nBasis().  Returns a null pointer if the
+         /// point is outside the significant radius of the Shell.
+         double const* evaluate(double const x, double const y, double const z, 
+            double* values) const;
+
+		 /// Evaluates the Shell over a block of n points whose coordinates are
+		 /// passed as separate x, y and z arrays.  The value of basis function
+		 /// b at point p is written to values[b*n+p], which must be at least
+		 /// nBasis()*n long, and is zero for points outside the significant
+		 /// radius.  The work buffer must be at least 5n long.  Returns false,
+		 /// without touching values, if none of the points lie within the
+         /// significant radius.  Thread safe.
+         bool evaluate(unsigned const n, double const* x, double const* y, 
+            double const* z, double* values, double* work) const;
+
          AngularMomentum angularMomentum() const { return m_angularMomentum; }
 
+         qglviewer::Vec const& position() const { return m_position; }
+
+		 /// This is numeric_limits<double>::max() until boundingBox() has 
+         /// been called.
+         double significantRadiusSquared() const { 
+            return m_significantRadiusSquared; 
+         }
+
          unsigned atomIndex() const { return m_atomIndex; }
 
          unsigned nBasis() const;
@@ -74,6 +100,7 @@ namespace Data {
 
          void serialize(InputArchive& ar, unsigned int const version = 0) {
             privateSerialize(ar, version);
+            packPrimitives();
          }  
          
          void serialize(OutputArchive& ar, unsigned int const version = 0) {
@@ -85,8 +112,8 @@ namespace Data {
 
       private:
 		 /// Shell values are stored in this static array, the length of which
-		 /// is sufficient for up to g angular momentum.  This could cause 
-         /// problems if Shells are ever used in parallel.
+		 /// is sufficient for up to g angular momentum.  Parallel evaluations
+         /// must use the evaluate() overload taking a buffer.
          static double s_values[15];
          static double s_zeroValues[15];
 
@@ -97,6 +124,10 @@ namespace Data {
          double computeSignificantRadius(double const thresh);
          void normalize();
 
+		 /// Copies the exponents and normalized coefficients into contiguous
+		 /// arrays for the evaluation kernels.
+         void packPrimitives();
+
          template <class Archive>
          void privateSerialize(Archive& ar, unsigned const) {
             ar & m_angularMomentum;
@@ -113,6 +144,9 @@ namespace Data {
          QList<double>   m_exponents;
          QList<double>   m_contractionCoefficients;
          double          m_significantRadiusSquared;
+
+         std::vector<double> m_alpha;
+         std::vector<double> m_coeff;
    };
 
 
@@ -0,0 +1,58 @@
+#ifndef IQMOL_DATA_SHELLKERNELS_H
+#define IQMOL_DATA_SHELLKERNELS_H
+/*******************************************************************************
+       
+  Copyright (C) 2011-2015 Andrew Gilbert
+           
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+       
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.  
+   
+********************************************************************************/
+
+
+namespace IQmol {
+namespace Data {
+namespace ShellKernels {
+
+   /// Computes the contracted radial part of a shell over a block of n points:
+   ///
+   ///    s[p] = sum_k coeff[k] * exp(-alpha[k] * r2[p])
+   ///
+   /// The points are processed four (AVX2) or two (SSE2) at a time using a
+   /// vectorized exp, with the instruction set chosen at run time.  Results
+   /// agree with the scalar std::exp version to within a few ulp.
+   void ContractPrimitives(unsigned const n, double const* r2, 
+      unsigned const nPrimitives, double const* alpha, double const* coeff, 
+      double* s);
+
+   /// Scalar reference version of ContractPrimitives.
+   void ContractPrimitivesScalar(unsigned const n, double const* r2, 
+      unsigned const nPrimitives, double const* alpha, double const* coeff, 
+      double* s);
+
+   /// Computes ir[p] = 1/sqrt(r2[p]) over a block of n points for the 1/r 
+   /// kernels.  The vector square root and division are correctly rounded,
+   /// and unlike std::sqrt they do not set errno, so the callers' loops over
+   /// the points are not serialized by the library call.
+   void InverseSqrt(unsigned const n, double const* r2, double* ir);
+
+   /// Returns the name of the instruction set used by ContractPrimitives
+   /// and InverseSqrt.
+   char const* InstructionSet();
+
+} } } // end namespace IQmol::Data::ShellKernels
+
+#endif
@@ -26,6 +26,9 @@
 #include "DataList.h"
 #include "Matrix.h"
 #include "Shell.h"
+#include <QByteArray>
+#include <QMap>
+#include <vector>
 
 
 namespace IQmol {
@@ -51,15 +54,34 @@ namespace Data {
       friend class boost::serialization::access;
 
       public:
-         ShellList() { }
+		 /// Scratch space for the grid point evaluations.  Each thread that
+		 /// evaluates the ShellList concurrently must use its own Workspace.
+		 /// The buffers are sized on first use.
+         struct Workspace {
+            Vector                basisValues;
+            std::vector<unsigned> sigBasis;
+            Matrix                basisBlock;
+            Matrix                orbitalBlock;
+            Matrix                densityBlock;
+            Matrix                factorBlock;
+            Matrix                localCoefficients;
+            Matrix                localFactors;
+            std::vector<double>   pointBuffer;
+            std::vector<double>   shellBlock;
+            std::vector<unsigned> sigShells;
+            std::vector<unsigned> localBasis;
+            std::vector<char>     shellMask;
+            double                shellValues[15];
+         };
+
+         ShellList() : m_nBasis(0), m_cellSize(0.0) { }
 
          ShellList(ShellData const& shellData, Geometry const& geometry);
 
-         ~ShellList();
-
          /// Returns the (-1,-1,-1) and (1,1,1) octant corners of a rectangular
          /// box that encloses the significant region of the Shells where 
-         /// significance is determined by thresh.  
+         /// significance is determined by thresh.  This also rebuilds the 
+         /// spatial index used to screen the shells for blocks of points.
          void boundingBox(qglviewer::Vec& min, qglviewer::Vec& max, 
             double const thresh = 0.001);
 
@@ -80,27 +102,48 @@ namespace Data {
          /// to the list and before shellValues or shellPairValues is called.
          void resize();
 
-         Vector const& shellValues(double const x, double const y, double const z);
+         /// Not thread safe, uses the internal buffers.
          Vector const& shellValues(qglviewer::Vec const& gridPoint);
 
+         /// Thread safe provided each thread passes its own Workspace.
+         Vector const& shellValues(double const x, double const y, double const z,
+            Workspace&) const;
+
+		 /// Evaluates all the basis functions over a block of points, passed 
+		 /// as an n x 3 matrix of coordinates.  The values are returned as an 
+		 /// n x nBasis matrix.  Only the shells that reach the bounding box of
+         /// the points are evaluated, the remaining columns are zero.
+         Matrix const& basisValues(Matrix const& points, Workspace&) const;
+
+		 /// Returns true if the significant region of any shell reaches the 
+		 /// box, i.e. if the shell values may exceed the threshold passed to 
+         /// boundingBox() somewhere within it.
+         bool isSignificant(qglviewer::Vec const& min, qglviewer::Vec const& max) const;
+
          // Returns the vectorized upper triangular array of unique shell 
          // values at the grid point pairs.
          Vector const& shellPairValues(qglviewer::Vec const& gridPoint);
 
 		 // Initializes the list of densities to be evaluated a grid points
-		 // with subsequent densityValues calls.
+		 // with subsequent densityValues calls.  Density vectors are upper 
+		 // triangular.  Each density is factorized as L D L^T, those that 
+         // cannot be factorized are evaluated using the basis pair loop.
          void setDensityVectors(QList<Vector const*> const& densities);
 
-         // Returns a list of the densities evaulated at the given grid point
-         // Density vectors are upper triangular
-         Vector const& densityValues(double const x, double const y, double const z);
+		 // Returns the densities evaluated over a block of points (n x 3) as
+		 // an n x nDensities matrix.  For the factorized densities the factors
+         // are evaluated with a matrix product and the squares summed.
+         Matrix const& densityValues(Matrix const& points, Workspace&) const;
 
 		 // Initializes the list of orbitlas to be evaluated a grid points
-		 // with subsequent orbitalValues calls.
+		 // with subsequent orbitalValues calls.  The requested rows of the 
+         // coefficient matrix are gathered into a contiguous block.
          void setOrbitalVectors(Matrix const& coefficients, QList<int> const& indices);
 
-         // Returns a list of the orbitals evaulated at the given grid point
-         Vector const& orbitalValues(double const x, double const y, double const z);
+		 // Returns the orbitals evaluated over a block of points (n x 3) as an
+		 // n x nOrbitals matrix.  The orbitals are formed with a single 
+         // matrix-matrix product of the basis function values.
+         Matrix const& orbitalValues(Matrix const& points, Workspace&) const;
 
          // Shell offset for each atom
          QList<unsigned> shellAtomOffsets() const;
@@ -110,6 +153,7 @@ namespace Data {
 
          void serialize(InputArchive& ar, unsigned int const version = 0) {
             serializeList(ar, version);
+            resize();
          }  
          
          void serialize(OutputArchive& ar, unsigned int const version = 0) {
@@ -122,16 +166,59 @@ namespace Data {
          unsigned m_nBasis;
          Vector   m_overlapMatrix;   // upper triangular
 
-         // These arrays are workspace buffers for gridpoint evaluations;
-         unsigned* m_sigBasis;
+         // Workspace buffer for the non-threaded gridpoint evaluations
          Vector    m_basisValues;
-         Vector    m_densityValues;
-         Vector    m_orbitalValues;
 
-         Matrix const*        m_orbitalCoefficients;
-         QList<int>           m_orbitalIndices;
+		 // Finds the shells whose significant radius reaches the bounding box
+		 // of the points and stores them in the Workspace, along with the 
+		 // indices of their basis functions (in ascending order).  Returns 
+         // the number of local basis functions.
+         unsigned significantShells(Matrix const& points, Workspace&) const;
+
+		 // Evaluates the significant shells found above.  If compact is true
+		 // the values are returned as an n x nLocalBasis matrix with columns
+		 // ordered as Workspace::localBasis, otherwise as the full n x nBasis 
+         // matrix.
+         Matrix const& evaluateShells(Matrix const& points, Workspace&, 
+            bool const compact) const;
+
+         // Evaluates the density as a sum over significant basis pairs using
+         // the compact basis values.
+         double pairDensity(Matrix const& basis, unsigned const point, 
+            Vector const& density, Workspace&) const;
+
+		 // Bins the shells into a uniform grid of cells according to their
+		 // significant spheres.  Each cell lists the shells that may be 
+         // significant somewhere in it, stored contiguously.
+         void buildShellIndex();
+
+         std::vector<unsigned> m_shellOffsets;  // first basis function of each shell
+         qglviewer::Vec        m_cellOrigin;
+         double                m_cellSize;
+         unsigned              m_nCells[3];
+         std::vector<unsigned> m_cellStart;     // size nCells+1, empty if no index
+         std::vector<unsigned> m_cellShells;
+
+         Matrix               m_orbitalBlock;  // nBasis x nOrbitals
          QList<Vector const*> m_densityVectors;
 
+         // Factorized densities; columns m_densityOffsets[k] to 
+         // m_densityOffsets[k+1] of m_densityFactors correspond to density k.
+         // Densities with m_densityFactorized[k] false use the pair loop.
+         Matrix                m_densityFactors;  // nBasis x total rank
+         Vector                m_densityWeights;
+         std::vector<unsigned> m_densityOffsets;
+         std::vector<bool>     m_densityFactorized;
+
+         // Factorizations from previous setDensityVectors calls, keyed on a
+         // SHA-1 digest of the density vector contents.
+         struct DensityFactorization {
+            bool   factorized;
+            Matrix L;
+            Vector D;
+         };
+         QMap<QByteArray, DensityFactorization> m_factorizationCache;
+
          Vector    m_basisPairValues;  // Deprecate
    };
 
@@ -44,6 +44,7 @@ namespace Data {
          Surface() { }  // for serialization
 
          void computeSurfaceProperty(Function3D const&);
+         void computeSurfaceProperty(QList<MultiFunction3DBlock> const&);
          void computeIndexProperty();
          void clearSurfaceProperty();
          void getPropertyRange(double& min, double& max) const;
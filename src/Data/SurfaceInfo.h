@@ -63,6 +63,7 @@ namespace Data {
 
          void isovalueIsPercent(bool const tf) { m_isovalueIsPercent = tf; }
          void setIsovalue(double const isovalue) { m_isovalue = isovalue; }
+         void setQuality(unsigned const quality) { m_quality = quality; }
 
          QColor const& positiveColor() const { return m_positiveColor; }
          QColor const& negativeColor() const { return m_negativeColor; }
@@ -26,16 +26,14 @@
 #include "Function.h"
 #include "Matrix.h"
 #include "GridData.h"
+#include "ShellList.h"
+#include <vector>
 
 
 namespace IQmol {
 
    class MultiGridEvaluator;
 
-   namespace Data {
-      class ShellList;
-   }
-
    class BasisEvaluator : public Task {
 
       Q_OBJECT
@@ -54,16 +52,18 @@ namespace IQmol {
          void evaluatorFinished();
 
       private:
-		 // Fills the m_returnValues vector with the value of each requested
-		 // orbital at the given point.
-         Vector const& evaluate(double const x, double const y, double const z);
+		 // Fills the return values of the given worker with the value of each
+		 // requested basis function over the block of points.
+         Matrix const& evaluate(Matrix const& points, unsigned const worker);
          
-         MultiFunction3D     m_function;
          Data::GridDataList  m_grids;
          Data::ShellList&    m_shellList;
          QList<int>          m_indices;
-         Vector              m_returnValues;
          MultiGridEvaluator* m_evaluator;
+
+         // One per worker thread
+         std::vector<Data::ShellList::Workspace> m_workspaces;
+         std::vector<Matrix> m_returnValues;
    };
 
 } // end namespace IQmol
@@ -26,16 +26,14 @@
 #include "Function.h"
 #include "Matrix.h"
 #include "Task.h"
+#include "ShellList.h"
+#include <vector>
 
 
 namespace IQmol {
 
    class MultiGridEvaluator;
 
-   namespace Data {
-      class ShellList;
-   }
-
    class DensityEvaluator : public Task {
 
       Q_OBJECT
@@ -56,12 +54,13 @@ namespace IQmol {
          void evaluatorFinished();
 
       private:
-         MultiFunction3D      m_function;
          Data::GridDataList   m_grids;
          Data::ShellList&     m_shellList;
          QList<Vector const*> m_densities;
-         Vector               m_returnValues;
          MultiGridEvaluator*  m_evaluator;
+
+         // One per worker thread
+         std::vector<Data::ShellList::Workspace> m_workspaces;
    };
 
 } // end namespace IQmol
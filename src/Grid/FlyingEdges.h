@@ -0,0 +1,115 @@
+#ifndef IQMOL_GRID_FLYINGEDGES_H
+#define IQMOL_GRID_FLYINGEDGES_H
+/*******************************************************************************
+       
+  Copyright (C) 2011-2015 Andrew Gilbert
+           
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+       
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.  
+   
+********************************************************************************/
+
+#include "Mesh.h"
+#include "WorkerPool.h"
+#include "QGLViewer/vec.h"
+#include <vector>
+
+
+namespace IQmol {
+
+namespace Data {
+   class GridData;
+}
+
+   /// Isosurface extraction using the Flying Edges algorithm of Schroeder, 
+   /// Maynard and Geveci (2015).  The grid is processed in rows along z in
+   /// four passes, each parallel over x-slabs:
+   ///   1) classify the points against the isovalue,
+   ///   2) flag the intersected edges of each row, counting them and 
+   ///      recording the range of k over which the row is intersected,
+   ///   3) count the triangles in each row of cubes, trimmed to the range 
+   ///      of its four bounding rows,
+   ///   4) after a prefix sum over the counts, compute the vertices and 
+   ///      triangles directly into preallocated arrays.
+   /// The cube cases and triangulations are those of MarchingCubes, over the
+   /// same range of cubes, so the two produce equivalent meshes.
+   class FlyingEdges : public QObject {
+
+      Q_OBJECT
+
+      public:
+         /// As for MarchingCubes, the mesh is left empty if the terminate 
+         /// flag is set during the extraction.
+         FlyingEdges(Data::GridData const& grid, bool const* terminate = 0);
+         void generateMesh(double const isovalue, Data::Mesh&);
+
+      Q_SIGNALS:
+         void progress(double);  // 0.0-1.0
+
+      private:
+         // Runs one pass over the slabs, reporting progress from start to
+         // end.  Returns false if the extraction has been terminated.
+         bool runPass(WorkerPool&, WorkerPool::BlockFunction const&, 
+            unsigned const nSlabs, double const start, double const end);
+
+         void classifySlab(unsigned const i, unsigned const worker);
+         void edgeSlab(unsigned const i, unsigned const worker);
+         void countSlab(unsigned const i, unsigned const worker);
+         void generateSlab(unsigned const i, unsigned const worker);
+
+         // Indices within the trimmed domain, offset by 2 from the grid
+         unsigned point(unsigned const i, unsigned const j, unsigned const k) const {
+            return (i*m_nPoints[1] + j)*m_nPoints[2] + k;
+         }
+
+         unsigned row(unsigned const i, unsigned const j) const {
+            return i*m_nPoints[1] + j;
+         }
+
+         unsigned cubeCase(unsigned const i, unsigned const j, unsigned const k) const;
+
+         Data::GridData const& m_grid;
+         bool const* m_terminate;
+         qglviewer::Vec m_origin;
+         qglviewer::Vec m_delta;
+         double   m_isovalue;
+         unsigned m_nPoints[3];
+
+         unsigned char m_nTriangles[256];
+
+         // Per point: whether the value is at or below the isovalue, and a
+         // bit for each axis set if the edge starting at the point is cut.
+         std::vector<unsigned char> m_below;
+         std::vector<unsigned char> m_cuts;
+
+         // Per point row: the number of cut edges along each axis, the first 
+         // vertex index for each axis and the range of k with cut edges.
+         std::vector<unsigned> m_edgeCount;
+         std::vector<unsigned> m_vertexOffset;
+         std::vector<unsigned> m_first;
+         std::vector<unsigned> m_last;
+
+         // Per cube row: the number of triangles and the first triangle
+         std::vector<unsigned> m_triangleCount;
+         std::vector<unsigned> m_triangleOffset;
+
+         std::vector<double>   m_vertices;   // position and normal
+         std::vector<unsigned> m_triangles;
+   };
+
+} // end namespace IQmol
+
+#endif
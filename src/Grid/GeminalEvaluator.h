@@ -0,0 +1,109 @@
+#ifndef IQMOL_GRID_GEMINAL_EVALUATOR_H
+#define IQMOL_GRID_GEMINAL_EVALUATOR_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "Task.h"
+#include "Function.h"
+#include "Matrix.h"
+#include "GridData.h"
+#include "ShellList.h"
+#include <vector>
+
+
+namespace IQmol {
+
+   class MultiGridEvaluator;
+
+   // Evaluates geminal densities on grids.  Each density is given in 
+   // factorized form as a sum of squared functions, the factors for grid g
+   // being the rows offsets[g] to offsets[g+1]-1 of the factor matrix.  These
+   // are evaluated with a single matrix product per block of points and the
+   // grids hold the square root of the summed squares.
+   class GeminalDensityEvaluator : public Task {
+
+      Q_OBJECT
+
+      public:
+         GeminalDensityEvaluator(Data::GridDataList& grids, Data::ShellList& shellList, 
+            Matrix const& factors, QList<unsigned> const& offsets);
+
+      Q_SIGNALS:
+         void progress(int);
+
+      protected:
+         void run();
+
+      private Q_SLOTS:
+         void evaluatorFinished();
+
+      private:
+         Matrix const& densityValues(Matrix const& points, unsigned const thread);
+
+         Data::GridDataList  m_grids;
+         Data::ShellList&    m_shellList;
+         QList<unsigned>     m_offsets;
+         MultiGridEvaluator* m_evaluator;
+
+         // One per worker thread
+         std::vector<Data::ShellList::Workspace> m_workspaces;
+         std::vector<Matrix> m_densityBlocks;
+   };
+
+
+   // Computes the geminal orbital and geminal density grids in the background,
+   // grouping the grids by size as for the MolecularGridEvaluator.  The density 
+   // factors are as described for the GeminalDensityEvaluator with a set of 
+   // rows for each geminal, and the geminal index of the SurfaceType selects 
+   // the set.
+   class GeminalGridEvaluator : public Task {
+
+      Q_OBJECT
+
+      public:
+         GeminalGridEvaluator(Data::GridDataList& grids, Data::ShellList& shellList, 
+            Matrix const& orbitalCoefficients, Matrix const& densityFactors, 
+            QList<unsigned> const& factorOffsets);
+
+         Data::GridDataList const& getGrids() const { return m_grids; }
+
+      Q_SIGNALS:
+         void progressLabelText(QString const& label);
+         void progressMaximum(int max);
+         void progressValue(int progress);
+
+      protected:
+         void run();
+
+      private:
+         void runEvaluator(Task& evaluator);
+
+         Data::GridDataList m_grids;
+         Data::ShellList&   m_shellList;
+         Matrix const&      m_orbitalCoefficients;
+         Matrix const&      m_densityFactors;
+         QList<unsigned>    m_factorOffsets;
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -9,6 +9,9 @@ SOURCES += \
    $$PWD/BasisEvaluator.C \
    $$PWD/BoundingBoxDialog.C \
    $$PWD/DensityEvaluator.C \
+   $$PWD/FlyingEdges.C \
+   $$PWD/GeminalEvaluator.C \
+   $$PWD/GridCache.C \
    $$PWD/GridEvaluator.C \
    $$PWD/GridInfoDialog.C \
    $$PWD/GridProduct.C \
@@ -16,7 +19,9 @@ SOURCES += \
    $$PWD/MarchingCubes.C \
    $$PWD/MeshDecimator.C \
    $$PWD/MolecularGridEvaluator.C \
+   $$PWD/MolecularQuadrature.C \
    $$PWD/OrbitalEvaluator.C \
+   $$PWD/PointChargeTree.C \
    $$PWD/SurfaceGenerator.C \
   
 
@@ -25,6 +30,9 @@ HEADERS += \
    $$PWD/BasisEvaluator.h \
    $$PWD/BoundingBoxDialog.h \
    $$PWD/DensityEvaluator.h \
+   $$PWD/FlyingEdges.h \
+   $$PWD/GeminalEvaluator.h \
+   $$PWD/GridCache.h \
    $$PWD/GridEvaluator.h \
    $$PWD/GridInfoDialog.h \
    $$PWD/GridProduct.h \
@@ -32,7 +40,9 @@ HEADERS += \
    $$PWD/MarchingCubes.h \
    $$PWD/MeshDecimator.h \
    $$PWD/MolecularGridEvaluator.h \
+   $$PWD/MolecularQuadrature.h \
    $$PWD/OrbitalEvaluator.h \
+   $$PWD/PointChargeTree.h \
    $$PWD/SurfaceGenerator.h \
 
 FORMS += \
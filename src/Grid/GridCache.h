@@ -0,0 +1,102 @@
+#ifndef IQMOL_GRID_GRIDCACHE_H
+#define IQMOL_GRID_GRIDCACHE_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "Matrix.h"
+#include <QDir>
+#include <QMap>
+#include <QMutex>
+
+
+namespace IQmol {
+
+   namespace Data {
+      class GridData;
+      class GridSize;
+      class ShellList;
+      class SurfaceType;
+   }
+
+   /// On-disk cache of computed grid data that persists between sessions.
+   /// Grids are stored one per file, named by a hash of everything that 
+   /// determines their values: the basis, the orbital coefficients or density
+   /// matrix, the grid size, the surface type, the evaluation tolerance and the
+   /// storage precision.
+   /// The total size of the cache is capped, with the least recently used 
+   /// grids removed first.  The location and size are set in the Preferences
+   /// and the cache is disabled until the user gives it a size.
+   /// The values are stored in one raw block at the precision and with the
+   /// brick layout of the grid, so reading a grid is limited by the disk.
+   class GridCache {
+
+      public:
+         GridCache();
+
+         bool isEnabled() const { return m_maxSize > 0; }
+
+         /// Returns a hash of the basis which is used as a starting point for
+         /// the keys of all the grids computed from it.
+         static QByteArray fingerprint(Data::ShellList const&);
+
+         /// Returns the key for the grid of the given type and size.  The data
+         /// vector should contain the orbital coefficients or the density 
+         /// matrix elements used to compute the grid, if any.
+         static QString key(QByteArray const& fingerprint, Data::SurfaceType const&,
+            Data::GridSize const&, Vector const& data);
+
+         /// Returns true if the grid is in the cache, without reading it.
+         bool contains(QString const& key) const;
+
+         /// Returns a new GridData object read from the cache, or a null 
+         /// pointer if it is not found.  The caller takes ownership.
+         Data::GridData* find(QString const& key);
+
+         /// Saves the grid to the cache, evicting older grids as required.
+         bool insert(QString const& key, Data::GridData const&);
+
+      private:
+         // Entries are keyed by hash and hold the last access time (s)
+         typedef QMap<QString, uint> Index;
+
+         QString filePath(QString const& key) const;
+         void readIndex(Index&) const;
+
+         // These must be called with s_mutex held
+         void loadIndex();
+         void saveIndex();
+         void evict();
+
+         QDir   m_directory;
+         qint64 m_maxSize;
+
+         // The index is shared by all the instances, which are used from both
+         // the GUI and the evaluator threads.  Other sessions are allowed for
+         // by merging with the index file under a QLockFile when it is saved.
+         static QMutex  s_mutex;
+         static Index   s_index;
+         static QString s_indexDirectory;
+   };
+
+} // end namespace IQmol
+
+#endif
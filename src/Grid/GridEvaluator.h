@@ -24,6 +24,9 @@
 
 #include "Task.h"
 #include "Function.h"
+#include "WorkerPool.h"
+#include <QAtomicInt>
+#include <vector>
 
 
 namespace IQmol {
@@ -50,7 +53,13 @@ namespace IQmol {
 
    /// GridEvaluator for cases where it is more efficient to generate multiple
    /// grid data at a time.  For example, several molecular orbitals requiring
-   /// only one evaluation of the shell data at each point
+   /// only one evaluation of the shell data at each point.  The grid is split
+   /// into x-slabs which are evaluated concurrently by a pool of workers.
+   ///
+   /// With adaptive evaluation the grids are first computed on a coarse 
+   /// lattice and each lattice cell is recursively bisected only where the
+   /// values, or the error in interpolating them, exceed the tolerance.  The 
+   /// remaining points are trilinearly interpolated from the cell corners.
    class MultiGridEvaluator : public Task {
 
       Q_OBJECT
@@ -59,18 +68,75 @@ namespace IQmol {
          // Note we don't check for size consistency between the number of 
          // grids and the return on the MultiFunction3D object.
          MultiGridEvaluator(QList<Data::GridData*> grids, MultiFunction3D const& function,
-            double const thresh, bool const coarseGrain = true);
+            double const tolerance, bool const adaptive = true);
+
+		 /// Parallel version with one function per worker thread.  The 
+		 /// functions must be safe to call simultaneously, i.e. they must
+         /// not share any scratch space.
+         MultiGridEvaluator(QList<Data::GridData*> grids, 
+            QList<MultiFunction3D> const& functions, double const tolerance, 
+            bool const adaptive = true);
+
+		 /// As above, but the functions evaluate a block of points at a time 
+		 /// (a row of the grid along z) which allows the basis function values 
+         /// to be contracted using matrix-matrix products.
+         MultiGridEvaluator(QList<Data::GridData*> grids, 
+            QList<MultiFunction3DBlock> const& functions, double const tolerance, 
+            bool const adaptive = true);
+
+         /// The number of points explicitly evaluated and interpolated in
+         /// the last run.
+         unsigned nEvaluated() const;
+         unsigned nInterpolated() const;
 
       protected:
          void run();
 
       private:
-         void runCoarseGrain();
+         void init();
+         void runAdaptive(WorkerPool&);
+         void runBlocks(WorkerPool&, WorkerPool::BlockFunction const&, 
+            unsigned const nBlocks, int const progressOffset, int const progressWeight);
+
+         void evaluateSlab(unsigned const i, unsigned const worker);
+
+         // Adaptive passes, each block is an x-slab of the current lattice
+         // or of the cells on it.
+         void evaluateLatticeSlab(unsigned const block, unsigned const worker);
+         void testCellSlab(unsigned const block, unsigned const worker);
+         void refineLatticeSlab(unsigned const block, unsigned const worker);
+         void interpolateCellSlab(unsigned const block, unsigned const worker);
+
+         // Evaluates the function at the listed (i,j,k) triplets
+         void evaluatePoints(std::vector<unsigned> const& indices, 
+            unsigned const worker);
+
+         unsigned cellIndex(unsigned const a, unsigned const b, unsigned const c) const {
+            return (a*m_nCells[1] + b)*m_nCells[2] + c;
+         }
+
+         unsigned pointIndex(unsigned const i, unsigned const j, unsigned const k) const {
+            return (i*m_nPoints[1] + j)*m_nPoints[2] + k;
+         }
 
          QList<Data::GridData*> m_grids;
-         MultiFunction3D const& m_function;
-         double m_thresh;
-         bool m_coarseGrain;
+         QList<MultiFunction3DBlock> m_functions;
+         double m_tolerance;
+         bool m_adaptive;
+
+         // Current refinement state.  Cells have a side length of m_stride 
+         // points (except at the upper boundaries) and are only considered 
+         // if their parent cell was refined.
+         unsigned m_nPoints[3];
+         unsigned m_nCells[3];
+         unsigned m_coarseStride;
+         unsigned m_stride;
+         std::vector<char> m_candidate;
+         std::vector<char> m_refine;
+         std::vector<char> m_exact;
+
+         QAtomicInt m_nEvaluated;
+         QAtomicInt m_nInterpolated;
    };
 
 } // end namespace IQmol
@@ -24,6 +24,10 @@
 
 #include "Task.h"
 #include "Function.h"
+#include "WorkerPool.h"
+#include "QGLViewer/vec.h"
+#include <complex>
+#include <vector>
 
 
 namespace IQmol {
@@ -32,13 +36,28 @@ namespace IQmol {
       class GridData;
    }
 
+   /// Computes a radial function of the products of a set of grids, f_g,
+   /// over all pairs of points r1, r2, binned on |r1-r2|:
+   ///   RadialCorrelation:  dV^2 sum_{pairs} sum_g f_g(r1) f_g(r2)
+   ///   MaxAbsolute:        max_{pairs} |sum_g f_g(r1) f_g(r2)|
+   /// The correlation is obtained from the autocorrelation of each grid, 
+   /// computed by zero-padded 3D FFTs, in O(N log N).  The maximum cannot 
+   /// be factored this way, instead each point is paired with the points
+   /// within a precomputed neighbourhood of offsets, skipping points where
+   /// the grids are all negligible.  Pairs further apart than the cutoff 
+   /// are ignored, a cutoff of zero includes all pairs.  For large grids the
+   /// size of the FFT grid is capped, which can shorten the cutoff of the
+   /// correlation.  The grids must all be the same size.
    class GridProduct: public Task {
 
       Q_OBJECT
 
       public:
+         enum Mode { RadialCorrelation, MaxAbsolute };
+
          GridProduct(Vector& values, QList<Data::GridData const*>&  grids, 
-            double const binSize = 0.1);
+            double const binSize = 0.1, Mode const mode = MaxAbsolute,
+            double const cutoff = 0.0);
 
       Q_SIGNALS:
          void progressValue(int);
@@ -47,9 +66,49 @@ namespace IQmol {
          void run();
 
       private:
+         typedef std::complex<double> Complex;
+
+         void runBlocks(WorkerPool&, WorkerPool::BlockFunction const&, 
+            unsigned const nBlocks);
+
+         void limitPadding();
+         void radialCorrelation(WorkerPool&);
+         void transformLines(unsigned const block, unsigned const worker);
+         void accumulatePower(unsigned const i, unsigned const worker);
+         void binCorrelation(unsigned const i, unsigned const worker);
+
+         void maxAbsolute(WorkerPool&);
+         void maxAbsolutePlane(unsigned const i, unsigned const worker);
+
          Vector& m_values;
          QList<Data::GridData const*> m_grids;
          double  m_binSize;
+         Mode    m_mode;
+         double  m_cutoff;
+         unsigned m_nBins;
+         int      m_progress;
+
+         unsigned m_nPoints[3];
+         unsigned m_maxShift[3];     // largest offset along each axis
+         qglviewer::Vec m_delta;
+
+         // FFT data, padded to m_nPadded points along each axis
+         unsigned m_nPadded[3];
+         unsigned m_axis;
+         unsigned m_nLines[2];       // extent of the non-zero lines
+         bool     m_inverse;
+         std::vector<Complex> m_work;
+         std::vector<double>  m_power;
+         std::vector< std::vector<Complex> > m_twiddles;
+         std::vector< std::vector<Complex> > m_scratch;
+
+         // Sparse pair data
+         std::vector<int>      m_slot;      // row of each point, -1 if negligible
+         std::vector<double>   m_rows;      // grid values of the significant points
+         std::vector<int>      m_offsets;   // triples
+         std::vector<unsigned> m_offsetBins;
+
+         std::vector< std::vector<double> > m_workerBins;
    };
 
 } // end namespace IQmol
@@ -24,7 +24,8 @@
 
 #include "Mesh.h"
 #include "QGLViewer/vec.h"
-#include <QMap>
+#include <QtGlobal>
+#include <vector>
 
 
 namespace IQmol {
@@ -39,65 +40,21 @@ namespace Data {
    ///    Qt-Adaption Created on: 15.07.2009  Author: manitoo
    /// Adapted for use with precomputed grids February 2011
    /// Rewritten for Mesh support December 2013
+   ///
+   /// The active bricks of the grid are grouped into x-slabs which are 
+   /// processed concurrently.  Each slab accumulates its own vertex and 
+   /// triangle buffers, with the edge vertices shared between cubes found 
+   /// from a flat array indexed by edge.  The slabs are then merged into the
+   /// Mesh, matching the vertices on the planes shared between slabs by 
+   /// their packed 64-bit edge keys.
    class MarchingCubes : public QObject {
 
       Q_OBJECT
 
-      private:
-         // Utility class to allow for the creation of a vertex map
-         class Index {
-            public:
-               Index(unsigned const i = 0, unsigned const j = 0, unsigned const k = 0, 
-                  unsigned const direction = 0) : m_i(i), m_j(j), m_k(k), m_w(direction) { }
-
-               Index(Index const& that) { copy(that); }
-
-               Index& operator=(Index const& that) 
-               {
-                   if (this != &that) copy(that);
-                   return *this;
-               }
-
-               bool operator<(Index const& that) const
-               {
-                  if (m_i < that.m_i) return true;
-                  if (m_i > that.m_i) return false;
-
-                  if (m_j < that.m_j) return true;
-                  if (m_j > that.m_j) return false;
-
-                  if (m_k < that.m_k) return true;
-                  if (m_k > that.m_k) return false;
-
-                  return (m_w < that.m_w);
-               }
-
-               QString toString() const 
-               {
-                  QString s("(");
-                  s += QString::number(m_i);
-                  s += ",";
-                  s += QString::number(m_j);
-                  s += ",";
-                  s += QString::number(m_k);
-                  if (m_w == 0) s += " / x)";
-                  if (m_w == 1) s += " / y)";
-                  if (m_w == 2) s += " / z)";
-                  return s;
-               }
-
-            private:
-               unsigned m_i, m_j, m_k, m_w;
-
-               void copy(Index const& that) 
-               {
-                  m_i = that.m_i;  m_j = that.m_j;  m_k = that.m_k;  m_w = that.m_w;
-               }
-         };
-
-
       public:
-         MarchingCubes(Data::GridData const& grid);
+         /// If terminate is given, the extraction is abandoned, leaving the 
+         /// mesh empty, once the flag is set.
+         MarchingCubes(Data::GridData const& grid, bool const* terminate = 0);
          void generateMesh(double const isovalue, Data::Mesh&);
 
 
@@ -106,16 +63,41 @@ namespace Data {
 
 
       private:
+         // FlyingEdges shares the cube tables
+         friend class FlyingEdges;
+
+         // Output of a single slab.  Vertices are stored as position and 
+         // normal, the triangles as triplets of local vertex indices.
+         struct Slab {
+            std::vector<double>   vertices;
+            std::vector<quint64>  keys;
+            std::vector<char>     shared;
+            std::vector<unsigned> triangles;
+         };
+
+         // Per-thread scratch space mapping the edges of the current slab 
+         // to their local vertex index.
+         struct Workspace {
+            std::vector<unsigned> edgeVertex;
+            std::vector<unsigned> touched;
+         };
+
+         void marchSlab(unsigned const slab, unsigned const worker);
+
          /// Performs the Marching Cubes algorithm on a single cube.
-         void marchOnCube(int const ix, int const iy, int const iz);
+         void marchOnCube(unsigned const ix, unsigned const iy, unsigned const iz,
+            unsigned const lo, Slab&, Workspace&);
+
+         // Copies the slab buffers into the mesh
+         void mergeSlabs(Data::Mesh&);
 
 		 /// Finds the approximate point of intersection of the surface between
 		 /// two points with the values v1 and v2.
-         double getOffset(double const v1, double const v2);
+         double getOffset(double const v1, double const v2) const;
 
-         /// Adds a new vertex to the mesh
-         Data::OMMesh::VertexHandle createEdgeVertex(unsigned const edge, double const offset, 
-            qglviewer::Vec const& origin);
+         /// Appends a new vertex to the slab
+         void createEdgeVertex(unsigned const edge, double const offset, 
+            qglviewer::Vec const& origin, Slab&) const;
 
          // Static Data
          static const double   s_vertexOffset[8][3];
@@ -126,14 +108,19 @@ namespace Data {
          static const int      s_cubeEdgeFlags[256];
          static const int      s_triangleConnectionTable[256][16];
 
-         Data::Mesh*           m_mesh;
          Data::GridData const& m_grid;
+         bool const* m_terminate;
          qglviewer::Vec const& m_origin;
          qglviewer::Vec const& m_delta;
          unsigned m_nx, m_ny, m_nz;
          double   m_isovalue;
 
-         QMap<Index, Data::OMMesh::VertexHandle> m_vertexMap;
+         // Active bricks sorted by slab, those of slab s run from
+         // m_slabStart[s] to m_slabStart[s+1]
+         std::vector<unsigned>  m_bricks;
+         std::vector<unsigned>  m_slabStart;
+         std::vector<Slab>      m_slabs;
+         std::vector<Workspace> m_workspaces;
    };
 
 } // end namespace IQmol
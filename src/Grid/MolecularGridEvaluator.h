@@ -25,6 +25,7 @@
 #include "Task.h"
 #include "Matrix.h"
 #include "GridData.h"
+#include <QMap>
 
 
 namespace IQmol {
@@ -45,6 +46,12 @@ namespace IQmol {
 
          Data::GridDataList const& getGrids() const { return m_grids; }
 
+         /// Grids with a key are written to the GridCache once they have been
+         /// evaluated, so the disk writes do not hold up the GUI thread.
+         void setCacheKeys(QMap<Data::GridData const*, QString> const& keys) {
+            m_cacheKeys = keys;
+         }
+
       Q_SIGNALS:
          void progressLabelText(QString const& label);
          void progressMaximum(int max);
@@ -54,12 +61,15 @@ namespace IQmol {
          void run();
 
       private:
+         void allocateBricks(Data::GridDataList const& grids);
+
          Data::GridDataList m_grids;
          Data::ShellList&   m_shellList;
          Matrix const&      m_alphaCoefficients;
          Matrix const&      m_betaCoefficients;
 
          QList<Data::Density*> m_densities;
+         QMap<Data::GridData const*, QString> m_cacheKeys;
    };
 
 } // end namespace IQmol
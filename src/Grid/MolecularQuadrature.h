@@ -0,0 +1,156 @@
+#ifndef IQMOL_GRID_MOLECULARQUADRATURE_H
+#define IQMOL_GRID_MOLECULARQUADRATURE_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "Task.h"
+#include "Function.h"
+#include "WorkerPool.h"
+#include "QGLViewer/vec.h"
+#include <vector>
+
+
+namespace IQmol {
+
+   namespace Data {
+      class Geometry;
+   }
+
+   /// Numerical integration over all space using Becke's multicentre scheme.
+   /// Each atom carries a product grid of a Gauss-Chebyshev radial rule,
+   /// mapped to [0,inf) using the Bragg-Slater radius of the atom, and a
+   /// Lebedev angular rule.  The points are weighted with Becke's fuzzy cell
+   /// partitioning (including the atomic size adjustments) so the atomic 
+   /// grids sum to an integral over the molecule.  Points with negligible 
+   /// weights are discarded.
+   ///
+   /// The grid is built using QThread::idealThreadCount() workers.  The
+   /// functions are evaluated in blocks of points, in parallel with one
+   /// function per worker, and return the values of m functions at each 
+   /// point.  For each function the integral, e.g. an electron count, and
+   /// the contribution from each atomic cell, i.e. the Becke populations,
+   /// are accumulated.  Optionally the integrals of all products of pairs
+   /// of the functions are also formed, giving for example the overlap 
+   /// matrix of a set of orbitals.
+   ///
+   /// Coordinates are in the units used by the functions, which for the
+   /// ShellList is Angstroms.
+   class MolecularQuadrature : public Task {
+
+      Q_OBJECT
+
+      public:
+         /// Each worker is given its own copy of the point-wise function, so
+         /// the function must be reentrant.
+         MolecularQuadrature(Data::Geometry const&, Function3D const& function,
+            unsigned const nRadial = 75, unsigned const lebedevRule = 14);
+
+         MolecularQuadrature(Data::Geometry const&, MultiFunction3D const& function,
+            bool const products = false, unsigned const nRadial = 75, 
+            unsigned const lebedevRule = 14);
+
+         /// Parallel version with one function per worker thread.  The 
+         /// functions must be safe to call simultaneously, i.e. they must
+         /// not share any scratch space.  The number of functions limits the
+         /// number of workers used for the integration.
+         MolecularQuadrature(Data::Geometry const&, 
+            QList<MultiFunction3DBlock> const& functions, bool const products = false,
+            unsigned const nRadial = 75, unsigned const lebedevRule = 14);
+
+         /// Sets a function called on the quadrature thread before the grid
+         /// is built, for setting up the functions away from the GUI thread.
+         void setInitializer(boost::function<void ()> const& initializer) 
+         { 
+            m_initializer = initializer; 
+         }
+
+         unsigned nPoints() const { return m_weights.size(); }
+
+         /// The integral of each function
+         Vector const& integrals() const { return m_integrals; }
+
+         /// Contribution of each atom (rows) to the integral of each function
+         Matrix const& atomicIntegrals() const { return m_atomicIntegrals; }
+
+         /// Integrals of the products of the functions, if requested
+         Matrix const& productIntegrals() const { return m_productIntegrals; }
+
+      Q_SIGNALS:
+         void progress(int);
+
+      protected:
+         void run();
+
+      private:
+         void init(Data::Geometry const&, unsigned const nRadial, 
+            unsigned const lebedevRule);
+         void runBlocks(WorkerPool&, WorkerPool::BlockFunction const&, 
+            unsigned const nBlocks, int const progressOffset, 
+            double const progressWeight);
+
+         // Becke weights of the points in a radial shell, one shell per block
+         void weightShell(unsigned const shell, unsigned const worker);
+         void integrateBlock(unsigned const block, unsigned const worker);
+
+         double cellFunction(unsigned const atom, std::vector<double> const& distances) const;
+
+         boost::function<void ()> m_initializer;
+         QList<MultiFunction3DBlock> m_functions;
+         bool m_copyFunctions;
+         bool m_products;
+
+         unsigned m_nAtoms;
+         std::vector<qglviewer::Vec> m_centers;
+         std::vector<double> m_sizeAdjustment;   // a_ij
+         std::vector<double> m_inverseDistance;  // 1/R_ij
+
+         // Atomic grids, unit sphere points and weights (including 4 pi)
+         std::vector<double> m_radialPoints;
+         std::vector<double> m_radialWeights;
+         std::vector<double> m_radialScale;     // per atom
+         std::vector<double> m_sphere;
+         std::vector<double> m_sphereWeights;
+         unsigned m_nRadial;
+
+         // The shells of points before screening
+         std::vector< std::vector<double> > m_shellPoints;
+         std::vector< std::vector<double> > m_shellWeights;
+         std::vector< std::vector<double> > m_distances;  // per worker
+
+         // Molecular grid
+         std::vector<double>   m_points;  // triples
+         std::vector<double>   m_weights;
+         std::vector<unsigned> m_atoms;
+
+         // Accumulated per worker
+         std::vector<Matrix> m_workerAtomic;
+         std::vector<Matrix> m_workerProducts;
+         std::vector<Matrix> m_workerPoints;
+
+         Vector m_integrals;
+         Matrix m_atomicIntegrals;
+         Matrix m_productIntegrals;
+   };
+
+} // end namespace IQmol
+
+#endif
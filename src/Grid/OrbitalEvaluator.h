@@ -26,16 +26,14 @@
 #include "Function.h"
 #include "Matrix.h"
 #include "GridData.h"
+#include "ShellList.h"
+#include <vector>
 
 
 namespace IQmol {
 
    class MultiGridEvaluator;
 
-   namespace Data {
-      class ShellList;
-   }
-
    class OrbitalEvaluator : public Task {
 
       Q_OBJECT
@@ -54,13 +52,14 @@ namespace IQmol {
          void evaluatorFinished();
 
       private:
-         MultiFunction3D     m_function;
          Data::GridDataList  m_grids;
          Data::ShellList&    m_shellList;
          Matrix const&       m_coefficients;
          QList<int>          m_indices;
-         Vector              m_returnValues;
          MultiGridEvaluator* m_evaluator;
+
+         // One per worker thread
+         std::vector<Data::ShellList::Workspace> m_workspaces;
    };
 
 } // end namespace IQmol
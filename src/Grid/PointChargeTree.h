@@ -0,0 +1,88 @@
+#ifndef IQMOL_GRID_POINTCHARGETREE_H
+#define IQMOL_GRID_POINTCHARGETREE_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "QGLViewer/vec.h"
+#include <QList>
+#include <vector>
+
+
+namespace IQmol {
+
+   /// Barnes-Hut octree for evaluating the potential of a large set of point
+   /// charges.  Each cell carries a multipole expansion of its charges about
+   /// its centre, up to the given order (0 = charge, 1 = dipole, 2 = traceless
+   /// quadrupole).  A cell is used in place of its charges when its radius is
+   /// less than theta times its distance from the point, otherwise it is
+   /// opened.  The error of each such term is bounded by the total absolute 
+   /// charge of the cell times theta^(order+1) / (d - r), so theta controls
+   /// the accuracy.  The tree is read-only once built and may be evaluated
+   /// from several threads at once.
+   class PointChargeTree {
+
+      public:
+         PointChargeTree(QList<double> const& charges, 
+            QList<qglviewer::Vec> const& positions, unsigned const order = 2, 
+            double const theta = 0.4);
+
+         unsigned nCharges() const { return m_q.size(); }
+         unsigned order() const { return m_order; }
+         double theta() const { return m_theta; }
+
+         /// Returns sum q/r using the tree, in the units of the positions.
+         double potential(double const x, double const y, double const z) const;
+
+         /// As above, but summing over all the charges explicitly.
+         double directPotential(double const x, double const y, double const z) const;
+
+      private:
+         static unsigned const s_leafSize = 16;
+         static unsigned const s_maxDepth = 24;
+
+         struct Cell {
+            double   centre[3];
+            double   radius;       // of the sphere about the centre enclosing the charges
+            double   moments[10];  // q, x, y, z, xx, xy, xz, yy, yz, zz
+            unsigned first;        // range of the charges in the sorted arrays
+            unsigned count;
+            unsigned child[8];
+            unsigned nChildren;
+         };
+
+         // Builds the cell for the given range of charges and its descendants,
+         // returning its index.  The charges are reordered so that each cell
+         // holds a contiguous range.
+         unsigned build(unsigned const first, unsigned const count, unsigned const depth);
+         void computeMoments(Cell&) const;
+         double sum(unsigned const first, unsigned const count, 
+            double const x, double const y, double const z) const;
+
+         unsigned m_order;
+         double   m_theta;
+         std::vector<double> m_x, m_y, m_z, m_q;
+         std::vector<Cell> m_cells;
+   };
+
+} // end namespace IQmol
+
+#endif
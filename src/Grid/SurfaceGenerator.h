@@ -31,27 +31,47 @@ namespace Data {
    class GridData;
    class SurfaceInfo;
    class Surface;
+   class Mesh;
 }
 
 namespace Grid {
 
 
+   /// Generates the isosurfaces of a grid, and the negative surface for a
+   /// signed quantity, converting percentage isovalues as required.  Progress
+   /// is reported in percent for each mesh and no surface is returned if the
+   /// task is stopped.
    class SurfaceGenerator : public Task {
 
       Q_OBJECT
 
       public:
-         SurfaceGenerator(Data::GridData const& grid, Data::SurfaceInfo const&);
+         /// The isosurface extractors produce equivalent meshes and may be 
+         /// interchanged, e.g. for benchmarking.
+         enum Extractor { MarchingCubesExtractor = 0, FlyingEdgesExtractor };
+
+         /// The extractor defaults to that given in the Preferences
+         SurfaceGenerator(Data::GridData& grid, Data::SurfaceInfo const&);
+         SurfaceGenerator(Data::GridData& grid, Data::SurfaceInfo const&,
+            Extractor const);
          
          Data::Surface* getSurface() const;
 
       protected:
          void run();
 
+      private Q_SLOTS:
+         void meshProgress(double);
+
       private:
-         Data::GridData const&     m_grid;
+         void init();
+         void generateMesh(double const isovalue, Data::Mesh&);
+
+         Extractor                 m_extractor;
+         Data::GridData&           m_grid;
          Data::SurfaceInfo const&  m_surfaceInfo;
          Data::Surface*            m_surface;
+         int                       m_progressOffset;
    };
 
 } } // end namespace IQmol::Grid
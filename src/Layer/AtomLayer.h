@@ -45,7 +45,6 @@ namespace Layer {
 
       Q_OBJECT
 
-      using Primitive::drawLabel;
       friend class Molecule;
       friend class Bond;
       friend class Constraint;
@@ -80,19 +79,33 @@ namespace Layer {
          void draw();
          void drawFast();
          void drawSelected();
-         void drawLabel(Viewer& viewer, LabelType const, QFontMetrics&);
+         void drawVibrationVector() { if (s_vibrationDisplayVector) drawDisplacement(); }
+
+         /// Returns the label text, which is cached until the type or the
+         /// underlying data change.
+         QString const& label(LabelType const type);
          void povray(PovRayGen&);
 
+         /// Fills sphere with the centre, radius and color (8 floats) used
+         /// by drawPrivate() so the atom can be rendered in a batch.  Returns
+         /// false if the atom is not drawn as a shaded sphere, in which case
+         /// draw() or drawSelected() must be used instead.
+         bool sphere(GLfloat* sphere, bool const selected);
+
          void setAtomicNumber(unsigned int const Z);
          void setSmallerHydrogens(bool const tf) { m_smallerHydrogens = tf; }
          void setHideHydrogens(bool const tf) { m_hideHydrogens = tf; }
-         void setCharge(double const charge) {m_charge = charge; }
-         void setSpinDensity(double const spin) {m_spin = spin; }
+         void setCharge(double const charge) {m_charge = charge; invalidateLabel(); }
+         void setSpinDensity(double const spin) {m_spin = spin; invalidateLabel(); }
          void setIndex(int const index);
          void setReorderIndex(int const reorderIndex) { m_reorderIndex = reorderIndex; }
 
-         void setNmrShift(double const shift) {m_nmr = shift; m_haveNmrShift = true; }
-         void setNmrShielding(double const shift) {m_nmr = shift; m_haveNmrShift = false; }
+         void setNmrShift(double const shift) {
+            m_nmr = shift; m_haveNmrShift = true; invalidateLabel(); 
+         }
+         void setNmrShielding(double const shift) {
+            m_nmr = shift; m_haveNmrShift = false; invalidateLabel(); 
+         }
          bool haveNmrShift() const { return m_haveNmrShift; }
 
          int getAtomicNumber() const { return m_atomicNumber; }
@@ -110,7 +123,7 @@ namespace Layer {
          bool hideHydrogens() const { return (m_atomicNumber == 1 && m_hideHydrogens); }
 
          void resetMass();
-         void setMass(double const mass) { m_mass = mass; }
+         void setMass(double const mass) { m_mass = mass; invalidateLabel(); }
 
          QColor color() const { 
              QColor col;
@@ -137,6 +150,7 @@ namespace Layer {
 
       private:
          QString getLabel(LabelType const type);
+         void invalidateLabel() { m_labelType = -1; }
          void drawPrivate(bool selected);
          void drawDisplacement(); 
          void drawArrow(const qglviewer::Vec& from, const qglviewer::Vec& to);
@@ -167,6 +181,8 @@ namespace Layer {
          int     m_valency;
          int     m_hybridization;
          qglviewer::Vec m_displacement;
+         QString m_labelText;
+         int     m_labelType;   // of m_labelText, -1 if stale
    };
 
    
@@ -23,6 +23,7 @@
 ********************************************************************************/
 
 #include "PrimitiveLayer.h"
+#include <QVector>
 
 
 namespace IQmol {
@@ -51,6 +52,14 @@ namespace Layer {
          void setIndex(int const index);
          void povray(PovRayGen&);
 
+         /// Appends the cylinders (a, radius, b, colorA, colorB: 15 floats)
+         /// and spheres (centre, radius, color: 8 floats) that make up the
+         /// bond, including multiple-bond offsets and Plastic end caps, for
+         /// the batched impostor renderer.  Returns false if the bond must 
+         /// be drawn individually.
+         bool impostors(QVector<GLfloat>& cylinders, QVector<GLfloat>& spheres,
+            bool const selected);
+
          int getOrder() const { return m_order; }
          Atom* beginAtom() { return m_begin; }
          Atom* endAtom() { return m_end; }
@@ -69,6 +78,10 @@ namespace Layer {
          void povrayWireFrame(PovRayGen&);
          void povrayPlastic(PovRayGen&);
 
+         static void appendCylinder(QVector<GLfloat>&, qglviewer::Vec const& a, 
+            qglviewer::Vec const& b, GLfloat const radius, GLfloat const* colorA,
+            GLfloat const* colorB);
+
          // Static Data
          static GLfloat s_defaultColor[];        // Grey bonds for BallsAndSticks
          static GLfloat s_plasticColor[];        // Light grey for molymod-type
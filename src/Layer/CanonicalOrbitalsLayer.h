@@ -47,7 +47,9 @@ namespace Layer {
          CanonicalOrbitals(Data::CanonicalOrbitals&);
          ~CanonicalOrbitals() { }
 
-         void computeFirstOrderDensityMatrix();
+         // By default the maximum absolute product of the orbitals is binned,
+         // radialCorrelation selects the FFT based pair correlation instead.
+         void computeFirstOrderDensityMatrix(bool const radialCorrelation = false);
          
       protected:
          double alphaOrbitalEnergy(unsigned const i) const;
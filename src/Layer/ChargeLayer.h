@@ -47,8 +47,9 @@ namespace Layer {
          void draw();
          void drawFast() { }
          void drawSelected();
-         void drawLabel(QGLViewer& viewer, QFontMetrics& fontMetrics);
          void setCharge(double const charge);
+         QString const& label() const { return m_label; }
+         double getRadius(bool selected);
 
          QString toString();
 
@@ -56,7 +57,6 @@ namespace Layer {
          GLfloat m_color[4];
 
       private:
-         double getRadius(bool selected);
          void drawPrivate(bool selected);
          void drawCube(GLfloat size);
          void drawOctahedron(GLfloat size);
@@ -137,6 +137,13 @@ namespace Layer {
             s_cameraPivot = pivot; 
          }
 
+         /// Set while the colour-ID picking pass is drawn, during which 
+         /// objects must not bind their own shader programs.
+         static void SetPicking(bool const tf) 
+         { 
+            s_picking = tf; 
+         }
+
 
       public Q_SLOTS:
          virtual void setReferenceFrame(qglviewer::Frame* frame) { 
@@ -169,6 +176,7 @@ namespace Layer {
          static qglviewer::Vec s_cameraPosition;
          static qglviewer::Vec s_cameraDirection;
          static qglviewer::Vec s_cameraPivot;
+         static bool s_picking;
          qglviewer::Frame m_frame;
          double m_alpha;   
          GLuint m_callList;
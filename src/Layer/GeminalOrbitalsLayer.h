@@ -32,8 +32,12 @@
 #include <QPair>
 
 
+class QProgressDialog;
+
 namespace IQmol {
 
+class GeminalGridEvaluator;
+
 namespace Data {
    class GeminalOrbitals;
 }
@@ -78,19 +82,17 @@ namespace Layer {
       private Q_SLOTS:
          void showGridInfo();
          void editBoundingBox();
+         void gridEvaluatorFinished();
+         void gridEvaluatorCanceled();
+         void calculateSurfaces();
 
       private:
-         // Returns false if the user cancels the calculation
-         bool computeOrbitalGrids(Data::GridDataList& grids);
-         bool computeDensityGrids(Data::GridDataList& grids);
-         void computeDensityVectors();
+         void computeDensityFactors();
          void initGeminalOrbitalProperties();
-         void computeShellPairs(qglviewer::Vec const& gridPoint);
 
          Data::GridData* findGrid(Data::SurfaceType const& type, 
             Data::GridSize const& size, Data::GridDataList const& gridList);
 
-         bool processGridQueue(GridQueue const&);
          Data::Surface* generateSurface(Data::SurfaceInfo const&);
          void dumpGridInfo() const;
          void appendSurfaces(Data::SurfaceList&);
@@ -100,14 +102,17 @@ namespace Layer {
          Configurator::GeminalOrbitals m_configurator;
          Data::GeminalOrbitals& m_geminalOrbitals;
 
-         QList<Vector*> m_densityVectors;
-         
-         Vector m_shellPairValues;
-         Vector m_shellValues;
-
-         SurfaceInfoQueue   m_surfaceInfoQueue;
-         Data::GridDataList m_availableGrids;
-         qglviewer::Vec     m_bbMin, m_bbMax;   // bounding box
+         // Each geminal density is a sum of squared orbitals, stored as the
+         // rows of orbital coefficients scaled by the root of their weights.
+         // The rows for geminal n are m_factorOffsets[n] to [n+1]-1.
+         Matrix          m_densityFactors;
+         QList<unsigned> m_factorOffsets;
+
+         SurfaceInfoQueue      m_surfaceInfoQueue;
+         Data::GridDataList    m_availableGrids;
+         qglviewer::Vec        m_bbMin, m_bbMax;   // bounding box
+         GeminalGridEvaluator* m_gridEvaluator;
+         QProgressDialog*      m_progressDialog;
    };
 
 
@@ -182,6 +182,10 @@ namespace IQmol {
             qglviewer::Vec centerOfNuclearCharge();
             QStringList getAvailableProperties(); 
             Function3D getPropertyEvaluator(QString const& name);
+
+            // Returns the batched evaluators of the property, one per thread
+            // where the property can be evaluated concurrently.
+            QList<MultiFunction3DBlock> getPropertyBlockEvaluators(QString const& name);
    
             /// Removes the specified Primitive(s) from the molecule, 
             /// but does not delete them. 
@@ -222,6 +226,9 @@ namespace IQmol {
    
             QList<qglviewer::Vec> coordinates();
             QList<double> atomicCharges(Data::Type::ID type);
+
+            // The values and positions of the visible external charges
+            void externalCharges(QList<double>& charges, QList<qglviewer::Vec>& positions);
             void setGeometry(IQmol::Data::Geometry&);
             QList<QString> atomicSymbols();
 
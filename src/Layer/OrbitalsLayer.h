@@ -28,7 +28,9 @@
 #include "SurfaceInfo.h"
 #include "OrbitalsConfigurator.h"
 #include "Density.h"
+#include "ShellList.h"
 #include <QPair>
+#include <QPointer>
 
 
 class QProgressDialog;
@@ -36,6 +38,7 @@ class QProgressDialog;
 namespace IQmol {
 
 class MolecularGridEvaluator;
+class MolecularQuadrature;
 
 namespace Data {
    class GridData;
@@ -97,14 +100,41 @@ namespace Layer {
       private Q_SLOTS:
          void showGridInfo();
          void editBoundingBox();
+         void integrateDensities();
+         void densityIntegrationFinished();
          void gridEvaluatorFinished();
          void gridEvaluatorCanceled();
          void calculateSurfaces();
+         void refinementFinished();
 
       private:
+         // A surface that has been displayed at a preview quality and is
+         // being refined in the background towards the requested quality.
+         struct Refinement {
+            Data::SurfaceInfo info;        // at the quality currently shown
+            unsigned targetQuality;
+            QPointer<Layer::Surface> layer;
+            int queueIndex;                // position in the preview queue
+         };
+
+         static unsigned const s_previewQuality;
+
+         // Returns true if the evaluator has been started, false if all the
+         // grids required by the queue are already available.
+         bool evaluateGrids(QList<Data::SurfaceInfo> const&, bool const showProgress);
+         void refineSurfaces();
+         void compressGrids();
+
+         // Returns true if the grid is only needed for a preview or an
+         // intermediate quality of a surface that is being refined.
+         bool isIntermediateGrid(Data::GridData const&) const;
+
          Data::GridData* findGrid(Data::SurfaceType const& type, 
             Data::GridSize const& size, Data::GridDataList const& gridList);
          Data::Surface* generateSurface(Data::SurfaceInfo const&);
+
+         // Returns the key used to store the grid in the GridCache
+         QString cacheKey(Data::SurfaceType const&, Data::GridSize const&);
          void dumpGridInfo() const;
          void appendSurfaces(Data::SurfaceList&);
 
@@ -115,10 +145,16 @@ namespace Layer {
          typedef QList<Data::SurfaceInfo> SurfaceInfoQueue;
 
          SurfaceInfoQueue        m_surfaceInfoQueue;
+         QList<Refinement>       m_refinements;
+         bool                    m_refining;
+         bool                    m_restartQueue;
          Data::GridDataList      m_availableGrids;
          qglviewer::Vec          m_bbMin, m_bbMax;   // bounding box
          MolecularGridEvaluator* m_molecularGridEvaluator;
          QProgressDialog*        m_progressDialog;
+         MolecularQuadrature*    m_quadrature;
+         std::vector<Data::ShellList::Workspace> m_quadratureWorkspaces;
+         QByteArray              m_basisFingerprint;
    };
 
 } } // End namespace IQmol::Layer 
@@ -56,7 +56,6 @@ namespace Layer {
            
          virtual ~Primitive() { }
 
-         virtual void drawLabel(QGLViewer&, QFontMetrics&) {  }
          virtual void setIndex(int const index) { m_index = index; }
          int  index() const { return m_index; }
          void setScale(double const scale) { m_scale = scale; }
@@ -36,6 +36,7 @@ namespace IQmol {
 
    class MeshDecimatorTask;
    class PovRayGen;
+   class ShaderLibrary;
 
    namespace Layer {
 
@@ -69,6 +70,17 @@ namespace IQmol {
             void setMolecule(Molecule*);
             void setCheckStatus(Qt::CheckState const);
 
+            // Replaces the meshes with those of the given surface, used to
+            // swap in a refined surface.  Returns false if the meshes are 
+            // currently being decimated.
+            bool replaceMeshes(Data::Surface&);
+
+            // Installed by the Viewer, this provides the GL functions used to
+            // manage the vertex buffers and builds the gradient program.
+            static void SetShaderLibrary(ShaderLibrary* library) {
+               s_shaderLibrary = library;
+            }
+
          protected:
             void setColors(QList<QColor> const& colors);
             void setColors(QColor const& negative, QColor const& positive);
@@ -77,7 +89,7 @@ namespace IQmol {
 
             QList<QColor> const& colors() const;
 
-            void computePropertyData(Function3D const&);
+            void computePropertyData(QList<MultiFunction3DBlock> const&);
             void computeIndexField();
             void clearPropertyData();
             bool isSigned() const { return m_surface.isSigned(); }
@@ -97,8 +109,28 @@ namespace IQmol {
             void dumpMeshInfo() const;
    
          private:
-            void recompile();
-            GLuint compile(Data::Mesh const&);
+            // Vertex, normal and index buffers are uploaded once per mesh, the
+            // scalar (property) buffer whenever the property changes.
+            struct MeshBuffers {
+               MeshBuffers() : vertices(0), normals(0), indices(0), scalars(0), 
+                  nIndices(0) { }
+               GLuint  vertices;
+               GLuint  normals;
+               GLuint  indices;
+               GLuint  scalars;
+               GLsizei nIndices;
+            };
+
+            // Colors, alpha and the property range are applied when drawing, so
+            // only changes to the meshes or property data invalidate the buffers.
+            void invalidateBuffers(bool const scalarsOnly = false);
+            void updateBuffers(Data::Mesh const&, MeshBuffers&);
+            void updateScalars(Data::Mesh const&, MeshBuffers&);
+            void deleteBuffers(MeshBuffers&);
+            void updateGradient();
+            void drawBuffers(MeshBuffers const&, GLfloat const* color);
+            void drawElements(MeshBuffers const&, bool const scalars);
+            static bool initGradientProgram();
             bool isTransparent() const { return 0.01 <= m_alpha && m_alpha < 0.99; }
             void drawVertexNormals();
             void drawFaceNormals();
@@ -109,8 +141,13 @@ namespace IQmol {
             Configurator::Surface m_configurator;
             DrawMode m_drawMode;
    
-            GLuint  m_callListPositive; 
-            GLuint  m_callListNegative; 
+            MeshBuffers m_buffersPositive;
+            MeshBuffers m_buffersNegative;
+            bool m_buffersChanged;
+            bool m_scalarsChanged;
+
+            GLuint m_gradientTexture;
+            bool   m_gradientChanged;
             GLfloat m_colorPositive[4];
             GLfloat m_colorNegative[4];
 
@@ -119,6 +156,12 @@ namespace IQmol {
             bool m_balanceScale;  // for properties
 
             MeshDecimatorTask* m_decimator;
+
+            static ShaderLibrary* s_shaderLibrary;
+            static GLuint s_gradientProgram;
+            static GLint  s_scalarAttribute;
+            static bool   s_gradientProgramInitialized;
+            static int const s_gradientSize = 512;
             void povray(PovRayGen&, Data::OMMesh const&, QColor const&);
             void povrayLines(PovRayGen&, Data::OMMesh const&, QColor const&);
       };
@@ -26,6 +26,7 @@
 #include "Data.h"
 #include "GridData.h"
 #include "MultipoleExpansion.h"
+#include "PointChargeTree.h"
 #include "QGLViewer/vec.h"
 #include <QList>
 
@@ -54,6 +55,13 @@ namespace IQmol {
 
          virtual Function3D const& evaluator() { return m_function; }
 
+		 /// Returns functions that evaluate the property over blocks of points
+		 /// (as an n x 1 matrix), which may be called concurrently, one from 
+		 /// each thread.  The default wraps the point-wise evaluator in a single
+		 /// function, as it may not be thread safe.  Returns an empty list if 
+         /// the property cannot be evaluated.
+         virtual QList<MultiFunction3DBlock> blockEvaluators(unsigned const nThreads);
+
       protected:
          Function3D m_function;
 
@@ -97,18 +105,26 @@ namespace IQmol {
 
 
 
+   /// The potential of the atomic charges of the given type, or of the
+   /// external charges for Data::Type::PointChargeList.  Sets of at least
+   /// Preferences::EspTreeThreshold() charges are evaluated using a 
+   /// PointChargeTree.
    class PointChargePotential : public SpatialProperty {
       public:
          PointChargePotential(Data::Type::ID type, QString const& label, 
             Layer::Molecule* molecule);
 
+         ~PointChargePotential();
+
          Function3D const& evaluator();
+         QList<MultiFunction3DBlock> blockEvaluators(unsigned const nThreads);
 
       private:
          Layer::Molecule* m_molecule;
          Data::Type::ID m_type;
          QList<double> m_charges;
          QList<qglviewer::Vec> m_coordinates;
+         PointChargeTree* m_tree;
          double potential(double const x, double const y, double const z) const;
    };
 
@@ -126,6 +142,8 @@ namespace IQmol {
          MultipolePotential(QString const& type, int const order, 
             Data::MultipoleExpansionList const& siteList);
 
+         QList<MultiFunction3DBlock> blockEvaluators(unsigned const nThreads);
+
       private:
          int m_order;
          Data::MultipoleExpansionList const& m_siteList;
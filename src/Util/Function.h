@@ -33,8 +33,52 @@ typedef boost::function<double (double const, double const, double const)> Funct
 
 typedef boost::function<Vector const& (double const, double const, double const)> MultiFunction3D;
 
+/// Evaluates several functions over a block of points.  The points are passed
+/// as an n x 3 matrix of coordinates and an n x m matrix of the m function 
+/// values at each point is returned.
+typedef boost::function<Matrix const& (Matrix const& points)> MultiFunction3DBlock;
+
 static Function3D NullFunction3D;
 
+
+/// Adapts a point-wise Function3D or MultiFunction3D to the block interface.
+/// Note that boost::function takes a copy of this, so each function gets its
+/// own buffer.
+class PointwiseBlockFunction {
+
+   public:
+      PointwiseBlockFunction(MultiFunction3D const& function) : m_function(function) { }
+
+      PointwiseBlockFunction(Function3D const& function) : m_scalar(function) { }
+
+      Matrix const& operator()(Matrix const& points) 
+      {
+         unsigned nPoints(points.size1());
+
+         if (m_scalar) {
+            m_values.resize(nPoints, 1, false);
+            for (unsigned p = 0; p < nPoints; ++p) {
+                m_values(p,0) = m_scalar(points(p,0), points(p,1), points(p,2));
+            }
+            return m_values;
+         }
+
+         for (unsigned p = 0; p < nPoints; ++p) {
+             Vector const& values(m_function(points(p,0), points(p,1), points(p,2)));
+             if (p == 0) m_values.resize(nPoints, values.size(), false);
+             for (unsigned f = 0; f < values.size(); ++f) {
+                 m_values(p,f) = values[f];
+             }
+         }
+         return m_values;
+      }
+
+   private:
+      MultiFunction3D m_function;
+      Function3D m_scalar;
+      Matrix m_values;
+};
+
 } // end namespace IQmol
 
 #endif
@@ -60,6 +60,22 @@ struct Array {
 QStringList PrintMatrix(Matrix const&, unsigned const columns = 6);
 QString PrintVector(Vector const&);
 
+/// Computes a low-rank factorization A = L D L^T of the symmetric matrix A 
+/// using diagonal pivoting, where L is n x rank and D holds the (possibly
+/// negative) pivots.  The factorization stops once the remaining diagonal 
+/// elements fall below tolerance*max|A_ij|.  Returns false if the residual 
+/// off-diagonal elements are still significant, which can happen for 
+/// indefinite matrices, in which case L and D should not be used.  The 
+/// default tolerance matches the precision of densities read from 
+/// formatted checkpoint files; smaller values only add noise vectors.
+bool FactorizeSymmetric(Matrix const& A, Matrix& L, Vector& D, 
+   double const tolerance = 1.0e-6);
+
+/// Forms the matrix product C = A B, resizing C if required.  This is a
+/// cache blocked level-3 product over the contiguous rows of the matrices,
+/// in place of a BLAS dgemm, and skips the zero elements of A.
+void MultiplyMatrices(Matrix const& A, Matrix const& B, Matrix& C);
+
 } // end namespace IQmol
 
 #endif
@@ -89,6 +89,10 @@ namespace Preferences {
    QVariantMap DefaultPovRayParameters();
    void        DefaultPovRayParameters(QVariantMap const&);
 
+   // Draw atoms (and other primitives) as batched, ray-cast impostors
+   bool    ImpostorRendering();
+   void    ImpostorRendering(bool const);
+
    QString QChemDatabaseFilePath();
    void    QChemDatabaseFilePath(QString const&);
 
@@ -109,6 +113,47 @@ namespace Preferences {
 
    double  SymmetryTolerance();
    void    SymmetryTolerance(double const);
+
+   int     NumberOfThreads();
+   void    NumberOfThreads(int const);
+
+   double  GridTolerance();
+   void    GridTolerance(double const);
+
+   QString GridCacheDirectory();
+   void    GridCacheDirectory(QString const&);
+
+   // In MB, a value of zero (the default) disables the cache
+   int     GridCacheSize();
+   void    GridCacheSize(int const);
+
+   bool    SinglePrecisionGrids();
+   void    SinglePrecisionGrids(bool const);
+
+   // Compression applied to idle grids, off by default:
+   // 0 = none, 1 = lossless, 2 = lossy
+   int     GridCompression();
+   void    GridCompression(int const);
+
+   // Isosurface extractor: 0 = marching cubes, 1 = flying edges
+   int     SurfaceExtractor();
+   void    SurfaceExtractor(int const);
+
+   // Show a coarse preview of orbital surfaces and refine it in the background
+   bool    ProgressiveSurfaces();
+   void    ProgressiveSurfaces(bool const);
+
+   // Multipole order (0-2) and opening angle of the tree used to evaluate 
+   // the potential of large numbers of point charges
+   int     EspTreeOrder();
+   void    EspTreeOrder(int const);
+
+   double  EspTreeTheta();
+   void    EspTreeTheta(double const);
+
+   // Number of point charges from which the tree is used
+   int     EspTreeThreshold();
+   void    EspTreeThreshold(int const);
    
    QColor PositiveSurfaceColor();
    void   PositiveSurfaceColor(QColor const&);
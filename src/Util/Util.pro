@@ -18,6 +18,7 @@ SOURCES = \
    $$PWD/SetButtonColor.C \
    $$PWD/Task.C \
    $$PWD/Timer.C \
+   $$PWD/WorkerPool.C \
    $$PWD/WriteToTemporaryFile.C \
 
 HEADERS = \
@@ -42,6 +43,7 @@ HEADERS = \
    $$PWD/StringFormat.h \
    $$PWD/Task.h \
    $$PWD/Timer.h \
+   $$PWD/WorkerPool.h \
    $$PWD/WriteToTemporaryFile.h \
 
 FORMS += \
@@ -0,0 +1,79 @@
+#ifndef IQMOL_UTIL_WORKERPOOL_H
+#define IQMOL_UTIL_WORKERPOOL_H
+/*******************************************************************************
+         
+  Copyright (C) 2011-2015 Andrew Gilbert
+      
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+         
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software  
+  Foundation, either version 3 of the License, or (at your option) any later  
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+      
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+   
+********************************************************************************/
+
+#include "boost/function.hpp"
+#include <QThreadPool>
+#include <QAtomicInt>
+
+
+namespace IQmol {
+
+   /// Distributes a set of independent blocks of work over a pool of worker
+   /// threads.  Blocks are handed out dynamically so uneven work loads
+   /// balance out.  The function is passed the block index along with the
+   /// index of the worker evaluating it, which allows callers to keep
+   /// per-thread scratch space.  Note that start() returns immediately, the
+   /// owning Task should poll waitForDone() and report progress.
+   class WorkerPool {
+
+      public:
+         typedef boost::function<void (unsigned const block, unsigned const worker)> 
+            BlockFunction;
+
+         /// A value of zero uses the number of threads set in the Preferences.
+         WorkerPool(unsigned const nWorkers = 0);
+         ~WorkerPool();
+
+         unsigned nWorkers() const { return m_nWorkers; }
+
+         void start(BlockFunction const& function, unsigned const nBlocks);
+
+         /// Returns true if all the blocks have been processed (or the pool 
+         /// has been stopped) within the given time in milliseconds.
+         bool waitForDone(int const msecs = -1);
+
+         /// Causes the workers to return once their current block is finished.
+         void stop();
+
+         unsigned blocksDone() const;
+
+      private:
+         class Worker;
+
+         unsigned      m_nWorkers;
+         unsigned      m_nBlocks;
+         BlockFunction m_function;
+         QThreadPool   m_threadPool;
+         QAtomicInt    m_nextBlock;
+         QAtomicInt    m_blocksDone;
+         QAtomicInt    m_stop;
+
+         // No copying allowed
+         WorkerPool(WorkerPool const&);
+         WorkerPool& operator=(WorkerPool const&);
+   };
+
+} // end namespace IQmol
+
+#endif
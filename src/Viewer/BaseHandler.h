@@ -60,6 +60,10 @@ namespace Handler {
          virtual ~Base() { }
          virtual Cursors::Type cursorType() const { return Cursors::OpenHand; }
          SelectionMode selectionMode() const { return m_selectionMode; }
+         bool isClickSelection() const { 
+            return m_selectionMode == AddClick || m_selectionMode == RemoveClick ||
+                   m_selectionMode == ToggleClick;
+         }
 
          virtual void mousePressEvent(QMouseEvent* e) {
             e->ignore();
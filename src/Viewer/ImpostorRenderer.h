@@ -0,0 +1,126 @@
+#ifndef IQMOL_VIEWER_IMPOSTORRENDERER_H
+#define IQMOL_VIEWER_IMPOSTORRENDERER_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include "GLObjectLayer.h"
+#include <QVector>
+
+
+class QGLFunctions;
+
+namespace IQmol {
+
+   class ShaderLibrary;
+
+   /// Draws atoms and bonds as ray-cast impostors.  Each sphere or cylinder
+   /// is a single view-facing quad and the fragment shader intersects the
+   /// view ray with the primitive to obtain the depth and normal, so each
+   /// kind of primitive is drawn from one vertex buffer with a single draw
+   /// call rather than tessellating a gluSphere or gluCylinder per object.
+   /// The lighting follows the fixed-function state (GL_LIGHT0 and the
+   /// front material) and, if GL_LIGHTING is disabled, the flat colour is
+   /// used as is required by the selection highlight.  As the uniforms of
+   /// the ShaderLibrary shaders are not applied, the Viewer only uses the
+   /// impostors when ShaderLibrary::NoShader is selected.
+   class ImpostorRenderer {
+
+      public:
+         ImpostorRenderer(ShaderLibrary&);
+         ~ImpostorRenderer();
+
+         bool isValid() const { return m_sphereProgram.id && m_cylinderProgram.id; }
+
+         /// Each pass that draws impostors during a frame has its own vertex
+         /// buffers.  Sharing a buffer between passes that draw different 
+         /// numbers of objects would force a full reupload for every pass.
+         enum Pass { Scene = 0, Build, Outline, Highlight, Picking, NumberOfPasses };
+
+         /// Draws the atoms and bonds that can be rendered as impostors and
+         /// returns the remaining objects, which must be drawn individually.
+         /// The Highlight pass draws the selection colour of the objects.
+         GLObjectList draw(GLObjectList const& objects, Pass const pass = Scene);
+
+         /// Draws the atoms and bonds for the colour-ID picking pass, using 
+         /// the index of each object plus one as its ID.  The indices of the 
+         /// objects that must be drawn individually are returned.
+         QList<int> drawIds(GLObjectList const& objects);
+
+      private:
+         struct Attribute {
+            char const* name;
+            int size;
+            int offset;
+         };
+
+         // The compiled program along with the layout of its vertices.
+         struct Program {
+            Program() : id(0), stride(0), lighting(-1) { }
+            unsigned id;
+            unsigned stride;
+            int lighting;
+            QList<Attribute> attributes;
+            QList<int> locations;
+         };
+
+         // A vertex buffer along with a copy of its current contents.  The
+         // vertices are regenerated on each frame, but only the blocks that
+         // differ from those already on the GPU are uploaded, so that moving
+         // a fragment only transfers the ranges that have changed.
+         class Batch {
+            public:
+               Batch() : m_buffer(0) { }
+               QVector<float>& vertices() { return m_vertices; }
+               unsigned upload(QGLFunctions*);
+               void destroy(QGLFunctions*);
+            private:
+               static int const s_blockSize = 1024;
+               unsigned m_buffer;
+               QVector<float> m_vertices;
+               QVector<float> m_uploaded;
+         };
+
+         void init();
+         bool initProgram(Program&, char const* vertexShader, char const* fragmentShader,
+            QString const& name);
+         void appendQuads(QVector<float>& vertices, QVector<GLfloat> const& records,
+            unsigned const recordSize);
+         void drawBatch(Program&, Batch&);
+         static void setColor(QVector<GLfloat>& records, int const begin, 
+            unsigned const recordSize, unsigned const offset, GLfloat const* color);
+
+         ShaderLibrary& m_shaderLibrary;
+         QGLFunctions*  m_glFunctions;
+
+         Program m_sphereProgram;
+         Program m_cylinderProgram;
+
+         Batch m_spheres[NumberOfPasses];
+         Batch m_cylinders[NumberOfPasses];
+
+         QVector<GLfloat> m_sphereRecords;
+         QVector<GLfloat> m_cylinderRecords;
+   };
+
+} // end namespace IQmol
+
+#endif
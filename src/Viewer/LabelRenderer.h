@@ -0,0 +1,107 @@
+#ifndef IQMOL_VIEWER_LABELRENDERER_H
+#define IQMOL_VIEWER_LABELRENDERER_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include "QGLViewer/vec.h"
+#include <QGLWidget>
+#include <QColor>
+#include <QFont>
+#include <QHash>
+#include <QImage>
+#include <QVector>
+
+
+namespace qglviewer {
+   class Camera;
+}
+
+namespace IQmol {
+
+   /// Draws text labels anchored to points in the scene.  The glyphs are
+   /// rasterized once into a texture atlas and all the labels queued for a
+   /// frame are drawn as textured quads with a single draw call, rather than
+   /// calling QGLWidget::renderText for each label.  The labels are depth
+   /// tested against the scene at their anchor points.
+   class LabelRenderer {
+
+      public:
+         LabelRenderer();
+         ~LabelRenderer();
+
+         /// Changing the font discards the atlas and the cached layouts.
+         void setFont(QFont const&);
+
+         void clear() { m_labels.clear(); }
+
+         /// Queues a label centred on position and moved towards the 
+         /// camera by offset, so that it sits in front of the object.
+         void add(qglviewer::Vec const& position, double const offset, 
+            QString const& text, QColor const& color);
+
+         void draw(qglviewer::Camera const&, int const width, int const height);
+
+      private:
+         struct Label {
+            qglviewer::Vec position;
+            double offset;
+            QString text;
+            QColor color;
+         };
+
+         // Position of the glyph in the atlas in pixels, along with its
+         // advance.  The cell includes padding for antialiasing.
+         struct Glyph {
+            int x, y;
+            int width, height;
+            int advance;
+         };
+
+         Glyph glyph(QChar const);
+
+         // Returns the quads (x, y, s, t per corner, in pixels) for the text
+         // relative to its anchor point.
+         QVector<GLfloat> const& layout(QString const& text);
+
+         void updateTexture();
+
+         static int const s_padding = 1;
+
+         QFont m_font;
+         QImage m_atlas;
+         int m_cursorX;
+         int m_cursorY;
+         int m_rowHeight;
+         bool m_atlasChanged;
+         GLuint m_texture;
+
+         QHash<QChar, Glyph> m_glyphs;
+         QHash<QString, QVector<GLfloat> > m_layouts;
+         QList<Label> m_labels;
+
+         QVector<GLfloat> m_vertices;
+         QVector<GLubyte> m_colors;
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef IQMOL_VIEWER_PICKBUFFER_H
+#define IQMOL_VIEWER_PICKBUFFER_H
+/*******************************************************************************
+
+  Copyright (C) 2011-2015 Andrew Gilbert
+
+  This file is part of IQmol, a free molecular visualization program. See
+  <http://iqmol.org> for more details.
+
+  IQmol is free software: you can redistribute it and/or modify it under the
+  terms of the GNU General Public License as published by the Free Software
+  Foundation, either version 3 of the License, or (at your option) any later
+  version.
+
+  IQmol is distributed in the hope that it will be useful, but WITHOUT ANY
+  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+  details.
+
+  You should have received a copy of the GNU General Public License along
+  with IQmol.  If not, see <http://www.gnu.org/licenses/>.
+
+********************************************************************************/
+
+#include <QGLFunctions>
+#include <QRect>
+#include <QVector>
+
+
+class QGLFramebufferObject;
+
+namespace IQmol {
+
+   class ShaderLibrary;
+
+   /// Off-screen colour-ID picking.  Each object is drawn with a flat colour
+   /// encoding its ID into an RGB framebuffer object that only covers the
+   /// pick region, and only those pixels are read back.  This replaces the
+   /// GL_SELECT render mode, which is emulated in software by many drivers.
+   /// An ID of zero is reserved for the background.
+   class PickBuffer {
+
+      public:
+         PickBuffer(ShaderLibrary&);
+         ~PickBuffer();
+
+         bool isValid() const { return m_program != 0; }
+
+         /// Binds the framebuffer, sized to the region, and the ID program.
+         /// The caller is responsible for loading a projection matrix that
+         /// maps the region onto the viewport (e.g. with gluPickMatrix).
+         bool begin(QSize const& region);
+
+         /// Sets the ID used for subsequent drawing.
+         void setId(unsigned const id);
+
+         /// Reads back the region and restores the previous state.  The IDs
+         /// are returned in row order, starting from the bottom left.
+         QVector<unsigned> end();
+
+         static void EncodeId(unsigned const id, GLfloat* rgba);
+         static unsigned DecodeId(GLubyte const* rgba);
+
+      private:
+         ShaderLibrary& m_shaderLibrary;
+         QGLFunctions*  m_glFunctions;
+         QGLFramebufferObject* m_frameBuffer;
+         unsigned m_program;
+         int m_idLocation;
+         QSize m_region;
+         GLint m_viewport[4];
+         GLint m_currentProgram;
+   };
+
+} // end namespace IQmol
+
+#endif
@@ -109,6 +109,14 @@ namespace IQmol {
          bool filtersActive() { return m_filtersActive; };
          bool shadersInitialized() const { return m_shadersInitialized; }
 
+         /// Builds a program from source held in memory.  Such programs are
+         /// used internally (e.g. by the ImpostorRenderer) and are not added 
+         /// to the list of available shaders.  Returns 0 on failure.
+         unsigned createProgram(QByteArray const& vertexSource, 
+            QByteArray const& fragmentSource, QString const& name);
+
+         QGLFunctions* glFunctions() { return m_glFunctions; }
+
          template <class T>
          void broadcast(QString const& variableName, T const& value) {
 #ifdef IQMOL_SHADERS
@@ -175,6 +183,9 @@ namespace IQmol {
          void loadShaders();
          unsigned createProgram(QString const& vertexPath, QString const& fragmentPath);
          unsigned loadShader(QString const& path, unsigned const mode);
+         unsigned compileShader(QByteArray const& source, unsigned const mode, 
+            QString const& name);
+         unsigned linkProgram(unsigned const vertexShader, unsigned const fragmentShader);
 
          QVariantMap parseUniformVariables(QString const& vertexShaderPath);
 
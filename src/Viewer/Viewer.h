@@ -32,6 +32,7 @@
 #include "BuildMoleculeFragmentHandler.h"
 #include "BuildFunctionalGroupHandler.h"
 #include "Cursors.h"
+#include "ImpostorRenderer.h"
 #include "ManipulateHandler.h"
 #include "ReindexAtomsHandler.h"
 #include "ManipulateSelectionHandler.h"
@@ -60,6 +61,8 @@ namespace IQmol {
    class ViewerModel;
    class ShaderDialog;
    class ShaderLibrary;
+   class PickBuffer;
+   class LabelRenderer;
    class CameraDialog;
 
    /// An OpenGL widget based that forms the main display of IQmol.
@@ -162,16 +165,24 @@ namespace IQmol {
          void draw();
          void fastDraw();
          void drawGlobals();
-         void drawObjects(GLObjectList const&);
+         void drawObjects(GLObjectList const&, 
+            ImpostorRenderer::Pass const = ImpostorRenderer::Scene);
          void drawSelected(GLObjectList const&);
+         bool impostorsActive() const;
          void drawLabels(GLObjectList const&);
          void displayGeometricParameter(GLObjectList const& selection);
          void displayMullikenDecomposition(GLObjectList const& selection);
          void drawWithNames(); 
+
+         /// Selects the objects under the select region centred on point
+         /// using the colour-ID pick buffer, falling back to GL_SELECT via
+         /// QGLViewer::select() if the buffer is unavailable.
+         void pick(QPoint const& point);
          void generatePovRay(QString const& filename);
 
          void drawSelectionRectangle(QRect const& rect) const;
          void endSelection(QPoint const&);
+         void selectHits(QList<int> const& hits, int const front);
          void postSelection(QPoint const&);
          void addToSelection(Layer::GLObject*);
          void addToSelection(int const id);
@@ -232,6 +243,9 @@ namespace IQmol {
          QTimer         m_recordTimer;
          QGLContext*    m_glContext;
          ShaderLibrary* m_shaderLibrary;
+         ImpostorRenderer* m_impostorRenderer;
+         PickBuffer*    m_pickBuffer;
+         LabelRenderer* m_labelRenderer;
          ShaderDialog*  m_shaderDialog;
          CameraDialog*  m_cameraDialog;
    };
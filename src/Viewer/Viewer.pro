@@ -18,9 +18,12 @@ SOURCES += \
    $$PWD/CameraDialog.C \
    $$PWD/Cursors.C \
    $$PWD/GLSLmath.C \
+   $$PWD/ImpostorRenderer.C \
+   $$PWD/LabelRenderer.C \
    $$PWD/ManipulateHandler.C \
    $$PWD/ManipulateSelectionHandler.C \
    $$PWD/ManipulatedFrameSetConstraint.C \
+   $$PWD/PickBuffer.C \
    $$PWD/PovRayGen.C \
    $$PWD/ReindexAtomsHandler.C \
    $$PWD/SelectHandler.C \
@@ -43,9 +46,12 @@ HEADERS += \
    $$PWD/CameraDialog.h \
    $$PWD/Cursors.h \
    $$PWD/GLSLmath.h \
+   $$PWD/ImpostorRenderer.h \
+   $$PWD/LabelRenderer.h \
    $$PWD/ManipulateHandler.h \
    $$PWD/ManipulateSelectionHandler.h \
    $$PWD/ManipulatedFrameSetConstraint.h \
+   $$PWD/PickBuffer.h \
    $$PWD/PovRayGen.h \
    $$PWD/ReindexAtomsHandler.h \
    $$PWD/SelectHandler.h \